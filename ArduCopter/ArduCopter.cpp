@@ -221,16 +221,23 @@ void Copter::fast_loop()
     // update INS immediately to get current gyro data populated
     ins.update();
 
-    // run low level rate controllers that only require IMU data
-    attitude_control->rate_controller_run();
+    // the rate loop thread runs the rate controllers and motor output if started
+    if (!rate_thread_started) {
+        // run low level rate controllers that only require IMU data
+        attitude_control->rate_controller_run();
 
-    // send outputs to the motors library immediately
-    motors_output();
+        // send outputs to the motors library immediately
+        motors_output();
+    }
 
     // run EKF state estimator (expensive)
     // --------------------
     read_AHRS();
 
+    // the rate loop thread runs the rate controllers on the motor and controller
+    // inputs set from here to the land detector, so it waits until they are all set
+    motors_lock();
+
 #if FRAME_CONFIG == HELI_FRAME
     update_heli_control_dynamics();
 #endif //HELI_FRAME
@@ -245,12 +252,19 @@ void Copter::fast_loop()
     // run the attitude controllers
     update_flight_mode();
 
+    // hand the new rate targets to the rate loop thread
+    if (rate_thread_started) {
+        rate_thread_publish();
+    }
+
     // update home from EKF if necessary
     update_home_from_EKF();
 
     // check if we've landed or crashed
     update_land_and_crash_detectors();
 
+    motors_unlock();
+
 #if MOUNT == ENABLED
     // camera mount's fast update
     camera_mount.update_fast();
@@ -268,14 +282,18 @@ void Copter::rc_loop()
 {
     // Read radio and 3-position switch on radio
     // -----------------------------------------
+    motors_lock();
     read_radio();
     read_control_switch();
+    motors_unlock();
 }
 
 // throttle_loop - should be run at 50 hz
 // ---------------------------
 void Copter::throttle_loop()
 {
+    motors_lock();
+
     // update throttle_low_comp value (controls priority of throttle vs attitude control)
     update_throttle_thr_mix();
 
@@ -290,6 +308,8 @@ void Copter::throttle_loop()
     heli_update_landing_swash();
 #endif
 
+    motors_unlock();
+
     // compensate for ground effect (if enabled)
     update_ground_effect_detector();
 }
@@ -428,12 +448,14 @@ void Copter::one_hz_loop()
         update_using_interlock();
 
         // check the user hasn't updated the frame class or type
+        motors_lock();
         motors->set_frame_class_and_type((AP_Motors::motor_frame_class)g2.frame_class.get(), (AP_Motors::motor_frame_type)g.frame_type.get());
 
 #if FRAME_CONFIG != HELI_FRAME
         // set all throttle channel settings
         motors->set_throttle_range(channel_throttle->get_radio_min(), channel_throttle->get_radio_max());
 #endif
+        motors_unlock();
     }
 
     // update assigned functions and enable auxiliary servos
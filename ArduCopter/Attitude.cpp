@@ -59,7 +59,9 @@ void Copter::update_throttle_hover()
     // calc average throttle if we are in a level hover
     if (throttle > 0.0f && abs(climb_rate) < 60 && labs(ahrs.roll_sensor) < 500 && labs(ahrs.pitch_sensor) < 500) {
         // Can we set the time constant automatically
+        motors_lock();
         motors->update_throttle_hover(0.01f);
+        motors_unlock();
     }
 #endif
 }
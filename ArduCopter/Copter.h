@@ -122,6 +122,10 @@
 #if MODE_FOLLOW_ENABLED == ENABLED
  # include <AP_Follow/AP_Follow.h>
 #endif
+#if MODE_SYSTEMID_ENABLED == ENABLED
+ # include <AP_Math/chirp.h>
+ # include <AP_Math/frequency_response.h>
+#endif
 #if AC_FENCE == ENABLED
  # include <AC_Fence/AC_Fence.h>
 #endif
@@ -498,6 +502,19 @@ private:
     AC_Circle *circle_nav;
 #endif
 
+    // rate loop thread, which runs the rate controllers and motor output when started
+    bool rate_thread_started;
+    // set by the main loop when the rate loop thread may send motor outputs
+    volatile bool rate_thread_output;
+    // last time the main loop published rate targets
+    volatile uint32_t rate_thread_publish_ms;
+    // rate loop period in seconds
+    float rate_thread_period_s;
+    // held while setting the motor and controller inputs or sending the motor outputs once the rate loop thread is started
+    AP_HAL::Semaphore *motors_sem;
+    // nesting depth of motors_lock() in the main loop
+    uint8_t motors_lock_depth;
+
     // System Timers
     // --------------
     // arm_time_ms - Records when vehicle was armed. Will be Zero if we are disarmed.
@@ -835,6 +852,8 @@ private:
     bool init_arm_motors(bool arming_from_gcs, bool do_arming_checks=true);
     void init_disarm_motors();
     void motors_output();
+    bool motors_output_update();
+    void motors_output_send();
     void lost_vehicle_check();
 
     // navigation.cpp
@@ -857,6 +876,15 @@ private:
     void init_precland();
     void update_precland();
 
+    // rate_thread.cpp
+    void rate_thread_init();
+    void rate_thread_publish();
+    void motors_lock();
+    void motors_unlock();
+#if RATE_THREAD_ENABLED == ENABLED
+    void rate_thread();
+#endif
+
     // radio.cpp
     void default_dead_zones();
     void init_rc_in();
@@ -1010,6 +1038,9 @@ private:
 #if !HAL_MINIMIZE_FEATURES && OPTFLOW == ENABLED
     ModeFlowHold mode_flowhold;
 #endif
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    ModeSystemId mode_systemid;
+#endif
 
     // mode.cpp
     Mode *mode_from_mode_num(const uint8_t mode);
@@ -1018,6 +1049,8 @@ private:
 public:
     void mavlink_delay_cb();    // GCS_Mavlink.cpp
     void failsafe_check();      // failsafe.cpp
+    bool failsafe_motors_lock();
+    void failsafe_motors_unlock();
 };
 
 extern const AP_HAL::HAL& hal;
@@ -587,6 +587,17 @@ public:
     AP_Follow follow;
 #endif
 
+#if RATE_THREAD_ENABLED == ENABLED
+    // rate loop thread
+    AP_Int8 rate_thread_enable;
+    AP_Int16 rate_thread_hz;
+#endif
+
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    // we need a pointer to the mode for the G2 table
+    void *mode_systemid_ptr;
+#endif
+
 };
 
 extern const AP_Param::Info        var_info[];
@@ -17,6 +17,9 @@ AP_AdvancedFailsafe_Copter::AP_AdvancedFailsafe_Copter(AP_Mission &_mission, con
  */
 void AP_AdvancedFailsafe_Copter::terminate_vehicle(void)
 {
+    // keep the rate loop thread off the motors and servos
+    copter.motors_lock();
+
     if (_terminate_action == TERMINATE_ACTION_LAND) {
         copter.set_mode(LAND, MODE_REASON_TERMINATE);
     } else {
@@ -37,6 +40,8 @@ void AP_AdvancedFailsafe_Copter::terminate_vehicle(void)
     }
 
     SRV_Channels::output_ch_all();
+
+    copter.motors_unlock();
 }
 
 void AP_AdvancedFailsafe_Copter::setup_IO_failsafe(void)
@@ -126,6 +126,9 @@ MAV_RESULT Copter::mavlink_compassmot(mavlink_channel_t chan)
 
     hal.scheduler->expect_delay_ms(5000);
 
+    // the motors are passed the throttle from here, not by the rate loop thread
+    motors_lock();
+
     // enable motors and pass through throttle
     init_rc_out();
     enable_motor_output();
@@ -238,6 +241,8 @@ MAV_RESULT Copter::mavlink_compassmot(mavlink_channel_t chan)
     motors->output_min();
     motors->armed(false);
 
+    motors_unlock();
+
     // set and save motor compensation
     if (updated) {
         compass.motor_compensation_type(comp_type);
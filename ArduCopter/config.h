@@ -52,6 +52,33 @@
     # define ARMING_DELAY_SEC 2.0f
 #endif
 
+//////////////////////////////////////////////////////////////////////////////
+// Rate loop thread - run the rate controllers and motor output on each gyro
+// sample in a thread apart from the main loop
+#ifndef RATE_THREAD_ENABLED
+ # if CONFIG_HAL_BOARD == HAL_BOARD_LINUX || CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+  # define RATE_THREAD_ENABLED ENABLED
+ # else
+  # define RATE_THREAD_ENABLED DISABLED
+ # endif
+#endif
+#ifndef RATE_THREAD_HZ_DEFAULT
+ # define RATE_THREAD_HZ_DEFAULT        1000    // rate loop thread rate in Hz
+#endif
+#ifndef RATE_THREAD_QUEUE_LENGTH
+ # define RATE_THREAD_QUEUE_LENGTH      32      // gyro samples queued for the rate loop thread
+#endif
+#ifndef RATE_THREAD_STACK
+ # if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+  # define RATE_THREAD_STACK            4096    // rate loop thread stack size in bytes
+ # else
+  # define RATE_THREAD_STACK            16384   // at least PTHREAD_STACK_MIN
+ # endif
+#endif
+#ifndef RATE_THREAD_TIMEOUT_MS
+ # define RATE_THREAD_TIMEOUT_MS        50      // rate loop thread stops output if the main loop has not published targets for this long
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // FRAME_CONFIG
 //
@@ -343,6 +370,12 @@
 # define MODE_SPORT_ENABLED !HAL_MINIMIZE_FEATURES
 #endif
 
+//////////////////////////////////////////////////////////////////////////////
+// System ID - frequency sweep to measure the response of a control loop, helicopters only
+#ifndef MODE_SYSTEMID_ENABLED
+# define MODE_SYSTEMID_ENABLED (FRAME_CONFIG == HELI_FRAME && !HAL_MINIMIZE_FEATURES)
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // Throw - fly vehicle after throwing it in the air
 #ifndef MODE_THROW_ENABLED
@@ -692,6 +725,10 @@
   #error Helicopter frame requires acro mode support which is disabled
 #endif
 
+#if MODE_SYSTEMID_ENABLED && FRAME_CONFIG != HELI_FRAME
+  #error ModeSystemId is only supported on helicopter frames
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // Developer Items
 //
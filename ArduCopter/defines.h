@@ -115,6 +115,7 @@ enum control_mode_t {
     SMART_RTL =    21,  // SMART_RTL returns to home by retracing its steps
     FLOWHOLD  =    22,  // FLOWHOLD holds position with optical flow without rangefinder
     FOLLOW    =    23,  // follow attempts to follow another vehicle or ground station
+    SYSTEMID  =    25,  // frequency sweep of an axis to measure the response of its control loop, helicopters only
 };
 
 enum mode_reason_t {
@@ -52,22 +52,51 @@ void Copter::failsafe_check()
         // motors are running but we have gone 2 second since the
         // main loop ran. That means we're in trouble and should
         // disarm the motors->
+        if (!failsafe_motors_lock()) {
+            // the main loop is stuck while updating the motors, try again next tick
+            return;
+        }
         in_failsafe = true;
         // reduce motors to minimum (we do not immediately disarm because we want to log the failure)
         if (motors->armed()) {
             motors->output_min();
         }
+        failsafe_motors_unlock();
         // log an error
         Log_Write_Error(ERROR_SUBSYSTEM_CPU,ERROR_CODE_FAILSAFE_OCCURRED);
     }
 
     if (failsafe_enabled && in_failsafe && tnow - failsafe_last_timestamp > 1000000) {
         // disarm motors every second
+        if (!failsafe_motors_lock()) {
+            return;
+        }
         failsafe_last_timestamp = tnow;
         if(motors->armed()) {
             motors->armed(false);
             motors->output();
         }
+        failsafe_motors_unlock();
+    }
+}
+
+/*
+  take the motors from the rate loop thread for the failsafe check,
+  returns true if the lock was taken. This runs in the timer thread so
+  must not block, and the failsafe never touches the motors without the
+  lock. The thread stops sending outputs once the main loop stops
+  publishing targets, so after two seconds the lock can only be held by
+  a main loop stuck while updating the motors.
+ */
+bool Copter::failsafe_motors_lock()
+{
+    return motors_sem == nullptr || motors_sem->take_nonblocking();
+}
+
+void Copter::failsafe_motors_unlock()
+{
+    if (motors_sem != nullptr) {
+        motors_sem->give();
     }
 }
 
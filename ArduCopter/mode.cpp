@@ -155,6 +155,12 @@ Copter::Mode *Copter::mode_from_mode_num(const uint8_t mode)
             break;
 #endif
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+        case SYSTEMID:
+            ret = (Copter::Mode *)g2.mode_systemid_ptr;
+            break;
+#endif
+
         default:
             break;
     }
@@ -195,7 +201,11 @@ bool Copter::set_mode(control_mode_t mode, mode_reason_t reason)
     }
 #endif
 
+    // the mode init and exit set the controller gains and motor inputs
+    motors_lock();
+
     if (!new_flightmode->init(ignore_checks)) {
+        motors_unlock();
         gcs().send_text(MAV_SEVERITY_WARNING,"Flight mode change failed");
         Log_Write_Error(ERROR_SUBSYSTEM_FLIGHT_MODE,mode);
         return false;
@@ -208,6 +218,9 @@ bool Copter::set_mode(control_mode_t mode, mode_reason_t reason)
     flightmode = new_flightmode;
     control_mode = mode;
     control_mode_reason = reason;
+
+    motors_unlock();
+
     DataFlash.Log_Write_Mode(control_mode, reason);
 
 #if ADSB_ENABLED == ENABLED
@@ -289,6 +302,13 @@ void Copter::exit_mode(Copter::Mode *&old_flightmode,
     }
 #endif
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    // stop the frequency sweep
+    if (old_flightmode == &mode_systemid) {
+        mode_systemid.exit();
+    }
+#endif
+
 #if FRAME_CONFIG == HELI_FRAME
     // firmly reset the flybar passthrough to false when exiting acro mode.
     if (old_flightmode == &mode_acro) {
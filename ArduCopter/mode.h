@@ -1139,6 +1139,59 @@ private:
 #endif
 
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+class ModeSystemId : public ModeStabilize_Heli {
+
+public:
+    // need a constructor for parameters
+    ModeSystemId(void);
+
+    bool init(bool ignore_checks) override;
+    void run() override;
+    void exit();
+
+    bool allows_arming(bool from_gcs) const override { return false; };
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+protected:
+
+    const char *name() const override { return "SYSTEMID"; }
+    const char *name4() const override { return "SYSI"; }
+
+private:
+
+    enum AxisType {
+        AXIS_ROLL = 1,
+        AXIS_PITCH = 2,
+        AXIS_YAW = 3,
+    };
+
+    // output of the rate controller to the motors for the axis under test
+    float get_axis_output() const;
+
+    // stop the sweep and report the results
+    void finish();
+
+    // parameters
+    AP_Int8 axis;                   // axis to sweep
+    AP_Float magnitude;             // magnitude of the sweep, as a fraction of the motors input range
+    AP_Float frequency_start;       // frequency at the start of the sweep, Hz
+    AP_Float frequency_stop;        // frequency at the end of the sweep, Hz
+    AP_Float time_record;           // duration of the sweep, s
+    AP_Float time_fade_in;          // time to fade in the sweep, s
+    AP_Float time_fade_out;         // time to fade out the sweep, s
+
+    Chirp chirp;
+    FrequencyResponse frequency_response;
+    bool running;
+    uint8_t sweep_axis;             // axis of the sweep in progress
+    float sweep_time;               // time since the start of the sweep, s
+    float injection;                // sweep value added to the axis at the last run
+};
+#endif
+
+
 class ModeThrow : public Mode {
 
 public:
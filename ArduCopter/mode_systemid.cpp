@@ -0,0 +1,225 @@
+#include "Copter.h"
+
+#if MODE_SYSTEMID_ENABLED == ENABLED
+
+/*
+  implement SYSTEMID mode, for measuring the response of the roll,
+  pitch or yaw control loop of a helicopter in flight.
+
+  The pilot flies as in stabilize while a logarithmic frequency sweep
+  is added to the output of the rate controller for one axis. The
+  frequency response from the motors input of that axis to the output
+  of the controllers, with the sign reversed, is the open loop response
+  of the angle and rate loops broken at the swashplate. From it the
+  crossover frequency, phase margin and closed loop bandwidth are
+  reported at the end of the sweep.
+ */
+
+const AP_Param::GroupInfo Copter::ModeSystemId::var_info[] = {
+    // @Param: _AXIS
+    // @DisplayName: System identification axis
+    // @Description: Axis the frequency sweep is added to
+    // @Values: 1:Roll,2:Pitch,3:Yaw
+    // @User: Standard
+    AP_GROUPINFO("_AXIS", 1, Copter::ModeSystemId, axis, AXIS_ROLL),
+
+    // @Param: _MAGNITUDE
+    // @DisplayName: System identification magnitude
+    // @Description: Magnitude of the frequency sweep, as a fraction of the range of the swashplate input of the axis
+    // @Range: 0.01 0.3
+    // @Increment: 0.01
+    // @User: Standard
+    AP_GROUPINFO("_MAGNITUDE", 2, Copter::ModeSystemId, magnitude, 0.05f),
+
+    // @Param: _F_START_HZ
+    // @DisplayName: System identification start frequency
+    // @Description: Frequency at the start of the sweep
+    // @Range: 0.1 5
+    // @Units: Hz
+    // @User: Standard
+    AP_GROUPINFO("_F_START_HZ", 3, Copter::ModeSystemId, frequency_start, 0.5f),
+
+    // @Param: _F_STOP_HZ
+    // @DisplayName: System identification stop frequency
+    // @Description: Frequency at the end of the sweep
+    // @Range: 1 40
+    // @Units: Hz
+    // @User: Standard
+    AP_GROUPINFO("_F_STOP_HZ", 4, Copter::ModeSystemId, frequency_stop, 15.0f),
+
+    // @Param: _T_REC
+    // @DisplayName: System identification record time
+    // @Description: Duration of the frequency sweep, including the fade in and fade out
+    // @Range: 5 60
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_REC", 5, Copter::ModeSystemId, time_record, 15.0f),
+
+    // @Param: _T_FADE_IN
+    // @DisplayName: System identification fade in time
+    // @Description: Time over which the magnitude of the sweep rises at the start
+    // @Range: 0 10
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_FADE_IN", 6, Copter::ModeSystemId, time_fade_in, 2.0f),
+
+    // @Param: _T_FADE_OUT
+    // @DisplayName: System identification fade out time
+    // @Description: Time over which the magnitude of the sweep falls at the end
+    // @Range: 0 10
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_FADE_OUT", 7, Copter::ModeSystemId, time_fade_out, 1.0f),
+
+    AP_GROUPEND
+};
+
+Copter::ModeSystemId::ModeSystemId(void) : ModeStabilize_Heli()
+{
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+// systemid_init - initialise the frequency sweep
+bool Copter::ModeSystemId::init(bool ignore_checks)
+{
+    if (!motors->armed() || ap.land_complete || !motors->rotor_runup_complete()) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "SysID: must be flying");
+        return false;
+    }
+    if (copter.rate_thread_started) {
+        // the rate loop thread updates the motor inputs between main
+        // loops, so they cannot be paired with the injection
+        gcs().send_text(MAV_SEVERITY_WARNING, "SysID: not with rate thread");
+        return false;
+    }
+    if (axis < AXIS_ROLL || axis > AXIS_YAW) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "SysID: invalid axis");
+        return false;
+    }
+    if (!ModeStabilize_Heli::init(ignore_checks)) {
+        return false;
+    }
+
+    chirp.init(time_record, frequency_start, frequency_stop, time_fade_in, time_fade_out);
+    frequency_response.init(frequency_start, frequency_stop, FrequencyResponse::MAX_BINS);
+    sweep_axis = axis;
+    sweep_time = 0.0f;
+    injection = 0.0f;
+    running = true;
+    attitude_control->set_rate_output_injection(Vector3f());
+
+    gcs().send_text(MAV_SEVERITY_INFO, "SysID: started axis %u", (unsigned)sweep_axis);
+    return true;
+}
+
+// systemid_exit - stop the sweep when leaving the mode
+void Copter::ModeSystemId::exit()
+{
+    if (running) {
+        running = false;
+        gcs().send_text(MAV_SEVERITY_INFO, "SysID: stopped");
+    }
+    attitude_control->set_rate_output_injection(Vector3f());
+}
+
+// systemid_run - runs the stabilize controller and the frequency sweep
+// should be called at 100hz or more
+void Copter::ModeSystemId::run()
+{
+    ModeStabilize_Heli::run();
+
+    if (!running) {
+        return;
+    }
+
+    // stop if the vehicle is no longer flying
+    if (!motors->armed() || ap.land_complete || !motors->get_interlock()) {
+        exit();
+        return;
+    }
+
+    // the rate controller ran with the last injection added to its output
+    const float input = get_axis_output();
+    const float controller = input - injection;
+    frequency_response.update(input, -controller, G_Dt);
+
+    sweep_time += G_Dt;
+    injection = chirp.update(sweep_time, magnitude);
+
+    // logged every loop, so the format is worked out at compile time
+    copter.DataFlash.Log_Write_Typed("SIDD", "TimeUS,Time,Freq,Inj,In,Ctrl",
+                                     AP_HAL::micros64(),
+                                     sweep_time,
+                                     chirp.get_frequency_hz(),
+                                     injection,
+                                     input,
+                                     controller);
+
+    if (chirp.completed()) {
+        finish();
+        return;
+    }
+
+    Vector3f injection_axes;
+    injection_axes[sweep_axis - AXIS_ROLL] = injection;
+    attitude_control->set_rate_output_injection(injection_axes);
+}
+
+// output of the rate controller to the motors for the axis under test
+float Copter::ModeSystemId::get_axis_output() const
+{
+    switch (sweep_axis) {
+    case AXIS_PITCH:
+        return motors->get_pitch();
+    case AXIS_YAW:
+        return motors->get_yaw();
+    case AXIS_ROLL:
+    default:
+        return motors->get_roll();
+    }
+}
+
+// stop the sweep and report the results
+void Copter::ModeSystemId::finish()
+{
+    running = false;
+    injection = 0.0f;
+    attitude_control->set_rate_output_injection(Vector3f());
+
+    for (uint8_t i = 0; i < frequency_response.get_num_bins(); i++) {
+        float gain, phase;
+        if (!frequency_response.get_response(i, gain, phase)) {
+            continue;
+        }
+        copter.DataFlash.Log_Write_Typed("SIDF", "TimeUS,Axis,Freq,Gain,Phase",
+                                         AP_HAL::micros64(),
+                                         sweep_axis,
+                                         frequency_response.get_frequency_hz(i),
+                                         gain,
+                                         degrees(phase));
+    }
+
+    float crossover_hz = 0.0f, phase_margin = 0.0f, bandwidth_hz = 0.0f;
+    const bool crossover_ok = frequency_response.get_crossover(crossover_hz, phase_margin);
+    const bool bandwidth_ok = frequency_response.get_closed_loop_bandwidth(bandwidth_hz);
+    copter.DataFlash.Log_Write_Typed("SIDR", "TimeUS,Axis,Cross,PM,BW",
+                                     AP_HAL::micros64(),
+                                     sweep_axis,
+                                     crossover_hz,
+                                     phase_margin,
+                                     bandwidth_hz);
+
+    if (crossover_ok) {
+        gcs().send_text(MAV_SEVERITY_INFO, "SysID: crossover %.1fHz PM %.0fdeg",
+                        (double)crossover_hz, (double)phase_margin);
+    } else {
+        gcs().send_text(MAV_SEVERITY_INFO, "SysID: no crossover in sweep");
+    }
+    if (bandwidth_ok) {
+        gcs().send_text(MAV_SEVERITY_INFO, "SysID: bandwidth %.1fHz", (double)bandwidth_hz);
+    } else {
+        gcs().send_text(MAV_SEVERITY_INFO, "SysID: no bandwidth in sweep");
+    }
+}
+
+#endif
@@ -147,11 +147,13 @@ MAV_RESULT Copter::mavlink_motor_test_start(mavlink_channel_t chan, uint8_t moto
             ap.motor_test = true;
 
             // enable and arm motors
+            motors_lock();
             if (!motors->armed()) {
                 init_rc_out();
                 enable_motor_output();
                 motors->armed(true);
             }
+            motors_unlock();
 
             // disable throttle and gps failsafe
             g.failsafe_throttle = FS_THR_DISABLED;
@@ -195,7 +197,9 @@ void Copter::motor_test_stop()
     ap.motor_test = false;
 
     // disarm motors
+    motors_lock();
     motors->armed(false);
+    motors_unlock();
 
     // reset timeout
     motor_test_start_ms = 0;
@@ -209,12 +209,16 @@ bool Copter::init_arm_motors(const bool arming_from_gcs, const bool do_arming_ch
     sprayer.test_pump(false);
 #endif
 
+    motors_lock();
+
     // enable output to motors
     enable_motor_output();
 
     // finally actually arm the motors
     motors->armed(true);
 
+    motors_unlock();
+
     // log arming to dataflash
     Log_Write_Event(DATA_ARMED);
 
@@ -265,6 +269,8 @@ void Copter::init_disarm_motors()
         }
     }
 
+    motors_lock();
+
 #if AUTOTUNE_ENABLED == ENABLED
     // save auto tuned parameters
     mode_autotune.save_tuning_gains();
@@ -280,6 +286,8 @@ void Copter::init_disarm_motors()
     // send disarm command to motors
     motors->armed(false);
 
+    motors_unlock();
+
 #if MODE_AUTO_ENABLED == ENABLED
     // reset the mission
     mission.reset();
@@ -296,6 +304,15 @@ void Copter::init_disarm_motors()
 
 // motors_output - send output to motors library which will adjust and send to ESCs and servos
 void Copter::motors_output()
+{
+    if (motors_output_update()) {
+        motors_output_send();
+    }
+}
+
+// motors_output_update - update the arming delay and motor interlock state
+// returns false if no output should be sent to the motors
+bool Copter::motors_output_update()
 {
 #if ADVANCED_FAILSAFE == ENABLED
     // this is to allow the failsafe module to deliberately crash
@@ -303,7 +320,7 @@ void Copter::motors_output()
     // OBC rules
     if (g2.afs.should_crash_vehicle()) {
         g2.afs.terminate_vehicle();
-        return;
+        return false;
     }
 #endif
 
@@ -312,6 +329,24 @@ void Copter::motors_output()
         ap.in_arming_delay = false;
     }
 
+    // the motor test sets the outputs itself
+    if (!ap.motor_test) {
+        bool interlock = motors->armed() && !ap.in_arming_delay && (!ap.using_interlock || ap.motor_interlock_switch) && !ap.motor_emergency_stop;
+        if (!motors->get_interlock() && interlock) {
+            motors->set_interlock(true);
+            Log_Write_Event(DATA_MOTORS_INTERLOCK_ENABLED);
+        } else if (motors->get_interlock() && !interlock) {
+            motors->set_interlock(false);
+            Log_Write_Event(DATA_MOTORS_INTERLOCK_DISABLED);
+        }
+    }
+
+    return true;
+}
+
+// motors_output_send - send output to the servos and motors, or the motor test output
+void Copter::motors_output_send()
+{
     // output any servo channels
     SRV_Channels::calc_pwm();
 
@@ -325,15 +360,6 @@ void Copter::motors_output()
     if (ap.motor_test) {
         motor_test_output();
     } else {
-        bool interlock = motors->armed() && !ap.in_arming_delay && (!ap.using_interlock || ap.motor_interlock_switch) && !ap.motor_emergency_stop;
-        if (!motors->get_interlock() && interlock) {
-            motors->set_interlock(true);
-            Log_Write_Event(DATA_MOTORS_INTERLOCK_ENABLED);
-        } else if (motors->get_interlock() && !interlock) {
-            motors->set_interlock(false);
-            Log_Write_Event(DATA_MOTORS_INTERLOCK_DISABLED);
-        }
-
         // send output signals to motors
         motors->output();
     }
@@ -0,0 +1,130 @@
+#include "Copter.h"
+
+/*
+  The rate loop thread runs the rate controllers and motor output on
+  each gyro sample, apart from the main loop, so that the EKF and the
+  outer loops do not add to the latency from the gyros to the motors.
+
+  The INS queues filtered samples of the gyro the AHRS is using. The
+  thread averages them down to RATE_THREAD_HZ and runs the rate
+  controllers with the rate targets and gyro drift estimate the main
+  loop last published, which it reads through a lock-free double
+  buffer. The thread blocks until the INS signals a new sample.
+
+  The motors have one owner at a time, whoever holds motors_sem. The
+  thread holds it while it runs the rate controllers and sends the
+  outputs. The main loop holds it, through motors_lock(), from the
+  flight mode update to the land detector and in every task or command
+  that sets the motor inputs, the arming state, the flight mode or the
+  controller gains, so the thread never sees them half updated. During
+  a motor test the main loop sends the outputs itself. The failsafe
+  timer only stops the motors when it can take the lock. The attitude
+  controller separately locks the rate PIDs against the thread.
+ */
+
+// rate_thread_init - start the rate loop thread if enabled, called once the gyros are calibrated
+void Copter::rate_thread_init()
+{
+#if RATE_THREAD_ENABLED == ENABLED
+    if (g2.rate_thread_enable <= 0 || rate_thread_started) {
+        return;
+    }
+
+    const uint16_t rate_hz = constrain_int16(g2.rate_thread_hz, scheduler.get_loop_rate_hz(), 2000);
+    rate_thread_period_s = 1.0f / rate_hz;
+
+    if (motors_sem == nullptr) {
+        motors_sem = hal.util->new_semaphore();
+    }
+    if (motors_sem == nullptr || !ins.init_rate_loop_samples(RATE_THREAD_QUEUE_LENGTH)) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Rate thread: no memory");
+        return;
+    }
+
+    // no output is sent until the main loop has published targets
+    rate_thread_output = false;
+    rate_thread_started = hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Copter::rate_thread, void),
+                                                       "rate", RATE_THREAD_STACK, AP_HAL::Scheduler::PRIORITY_BOOST, 0);
+    if (!rate_thread_started) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Rate thread: failed to start");
+        return;
+    }
+
+    // the motors are now output at the rate loop rate
+    motors->set_loop_rate(rate_hz);
+#endif
+}
+
+// rate_thread_publish - publish the rate targets to the rate loop thread and update the motor state,
+// called by the main loop with the motors locked once the attitude controllers have run
+void Copter::rate_thread_publish()
+{
+    // the drift estimate is for the gyro the AHRS is using
+    ins.set_rate_loop_gyro(ahrs.get_primary_gyro_index());
+    attitude_control->publish_rate_targets();
+
+    const bool output_ok = motors_output_update();
+    rate_thread_output = output_ok && !ap.motor_test;
+    rate_thread_publish_ms = AP_HAL::millis();
+    if (output_ok && ap.motor_test) {
+        // the main loop sends the outputs during a motor test
+        motors_output_send();
+    }
+}
+
+// motors_lock - take ownership of the motors from the rate loop thread, main loop only.
+// Calls nest, so a command can lock around code that locks again
+void Copter::motors_lock()
+{
+    if (motors_sem == nullptr || motors_lock_depth++ != 0) {
+        return;
+    }
+    motors_sem->take_blocking();
+}
+
+void Copter::motors_unlock()
+{
+    if (motors_sem == nullptr || --motors_lock_depth != 0) {
+        return;
+    }
+    motors_sem->give();
+}
+
+#if RATE_THREAD_ENABLED == ENABLED
+// rate_thread - main function of the rate loop thread
+void Copter::rate_thread()
+{
+    Vector3f gyro_sum;
+    float dt_sum = 0.0f;
+
+    while (true) {
+        Vector3f gyro;
+        float dt;
+        if (!ins.get_next_rate_loop_sample(gyro, dt)) {
+            // sleep until the INS signals the next sample from the gyro, the
+            // timeout only stops a failed gyro hanging the thread
+            ins.wait_rate_loop_sample(RATE_THREAD_TIMEOUT_MS * 1000UL);
+            continue;
+        }
+
+        // average the samples down to the rate loop rate
+        gyro_sum += gyro * dt;
+        dt_sum += dt;
+        if (dt_sum < 0.9f * rate_thread_period_s) {
+            continue;
+        }
+        gyro = gyro_sum / dt_sum;
+        dt = dt_sum;
+        gyro_sum.zero();
+        dt_sum = 0.0f;
+
+        // leave the motors alone while the main loop owns them or has stopped publishing
+        motors_sem->take_blocking();
+        if (rate_thread_output && AP_HAL::millis() - rate_thread_publish_ms <= RATE_THREAD_TIMEOUT_MS &&
+            attitude_control->rate_controller_run_gyro(gyro, dt)) {
+            motors_output_send();
+        }
+        motors_sem->give();
+    }
+}
+#endif
@@ -8,7 +8,9 @@ void Copter::read_barometer(void)
     baro_alt = barometer.get_altitude() * 100.0f;
     baro_climbrate = barometer.get_climb_rate() * 100.0f;
 
+    motors_lock();
     motors->set_air_density_ratio(barometer.get_air_density_ratio());
+    motors_unlock();
 }
 
 void Copter::init_rangefinder(void)
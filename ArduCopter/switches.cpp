@@ -163,12 +163,15 @@ void Copter::read_aux_switches()
     }
     bool need_log = false;
 
+    // the switches can set the motor inputs, arming state and flight mode
+    motors_lock();
     read_aux_switch(CH_7, aux_con.CH7_flag, g.ch7_option);
     read_aux_switch(CH_8, aux_con.CH8_flag, g.ch8_option);
     read_aux_switch(CH_9, aux_con.CH9_flag, g.ch9_option);
     read_aux_switch(CH_10, aux_con.CH10_flag, g.ch10_option);
     read_aux_switch(CH_11, aux_con.CH11_flag, g.ch11_option);
     read_aux_switch(CH_12, aux_con.CH12_flag, g.ch12_option);
+    motors_unlock();
     if (need_log) {
         DataFlash.Log_Write_RCIN();
     }
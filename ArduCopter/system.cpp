@@ -261,6 +261,9 @@ void Copter::init_ardupilot()
 
     startup_INS_ground();
 
+    // start the rate loop thread now the gyros are calibrated
+    rate_thread_init();
+
     // set landed flags
     set_land_complete(true);
     set_land_complete_maybe(true);
@@ -271,6 +271,11 @@ class sitl(Board):
             'SITL',
         ]
 
+        if cfg.options.enable_math_simd:
+            env.DEFINES.update(
+                AP_MATH_SIMD = 1,
+            )
+
         if cfg.options.enable_sfml:
             if not cfg.check_SFML(env):
                 cfg.fatal("Failed to find SFML libraries")
@@ -468,6 +473,15 @@ class linux(Board):
         if self.with_uavcan:
             cfg.define('UAVCAN_EXCEPTIONS', 0)
 
+        if cfg.options.enable_math_simd:
+            # falls back to the scalar code unless the toolchain targets SSE or NEON
+            env.DEFINES.update(
+                AP_MATH_SIMD = 1,
+            )
+            if self.toolchain == 'arm-linux-gnueabihf':
+                # all supported Cortex-A boards have NEON, but the toolchain default FPU does not
+                env.CXXFLAGS += ['-mfpu=neon']
+
         if cfg.options.apstatedir:
             cfg.define('AP_STATEDIR', cfg.options.apstatedir)
 
@@ -86,6 +86,11 @@ class VehicleInfo(object):
                 "default_params_filename": ["default_params/copter-heli.parm",
                                             "default_params/copter-heli-dual.parm"],
             },
+            "heli-bem": {
+                "make_target": "sitl-heli",
+                "waf_target": "bin/arducopter-heli",
+                "default_params_filename": "default_params/copter-heli.parm",
+            },
             "heli-compound": {
                 "make_target": "sitl-heli-compound",
                 "waf_target": "bin/arducopter-heli",
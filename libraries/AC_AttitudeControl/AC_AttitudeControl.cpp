@@ -2,6 +2,8 @@
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 
+extern const AP_HAL::HAL& hal;
+
 #if APM_BUILD_TYPE(APM_BUILD_ArduPlane)
  // default gains for Plane
  # define AC_ATTITUDE_CONTROL_INPUT_TC_DEFAULT  0.2f    // Soft
@@ -146,6 +148,28 @@ const AP_Param::GroupInfo AC_AttitudeControl::var_info[] = {
     AP_GROUPEND
 };
 
+AC_AttitudeControl::AC_AttitudeControl(AP_AHRS_View &ahrs,
+                                       const AP_Vehicle::MultiCopter &aparm,
+                                       AP_Motors& motors,
+                                       float dt) :
+    _p_angle_roll(AC_ATTITUDE_CONTROL_ANGLE_P),
+    _p_angle_pitch(AC_ATTITUDE_CONTROL_ANGLE_P),
+    _p_angle_yaw(AC_ATTITUDE_CONTROL_ANGLE_P),
+    _dt(dt),
+    _angle_boost(0),
+    _use_sqrt_controller(true),
+    _throttle_rpy_mix_desired(AC_ATTITUDE_CONTROL_THR_MIX_DEFAULT),
+    _throttle_rpy_mix(AC_ATTITUDE_CONTROL_THR_MIX_DEFAULT),
+    _ahrs(ahrs),
+    _aparm(aparm),
+    _motors(motors)
+{
+    AP_Param::setup_object_defaults(this, var_info);
+
+    // created before any rate loop thread can run the rate PIDs
+    _rate_sem = hal.util->new_semaphore();
+}
+
 // Set output throttle and disable stabilization
 void AC_AttitudeControl::set_throttle_out_unstabilized(float throttle_in, bool reset_attitude_control, float filter_cutoff)
 {
@@ -175,16 +199,27 @@ void AC_AttitudeControl::relax_attitude_controllers()
     // Initialize remaining variables
     _thrust_error_angle = 0.0f;
 
+    rate_lock();
+
     // Reset the PID filters
     get_rate_roll_pid().reset_filter();
     get_rate_pitch_pid().reset_filter();
     get_rate_yaw_pid().reset_filter();
 
     // Reset the I terms
-    reset_rate_controller_I_terms();
+    reset_rate_controller_I_terms_locked();
+
+    rate_unlock();
 }
 
 void AC_AttitudeControl::reset_rate_controller_I_terms()
+{
+    rate_lock();
+    reset_rate_controller_I_terms_locked();
+    rate_unlock();
+}
+
+void AC_AttitudeControl::reset_rate_controller_I_terms_locked()
 {
     get_rate_roll_pid().reset_I();
     get_rate_pitch_pid().reset_I();
@@ -818,6 +853,61 @@ Vector3f AC_AttitudeControl::update_ang_vel_target_from_att_error(Vector3f attit
     return rate_target_ang_vel;
 }
 
+// Run angular velocity controller and send outputs to the motors
+void AC_AttitudeControl::rate_controller_run()
+{
+    rate_controller_run_sample(_ahrs.get_gyro_latest(), _rate_target_ang_vel, _dt);
+    add_rate_output_injection(_rate_output_injection);
+}
+
+// Publish the angular velocity targets for a rate loop thread
+void AC_AttitudeControl::publish_rate_targets()
+{
+    rate_targets targets;
+    targets.ang_vel = _rate_target_ang_vel;
+    targets.gyro_drift = _ahrs.get_gyro_drift();
+    targets.output_injection = _rate_output_injection;
+    _rate_targets_published.write(targets);
+}
+
+// Run angular velocity controller on a gyro sample from the INS using the last published targets
+bool AC_AttitudeControl::rate_controller_run_gyro(const Vector3f &ins_gyro, float dt)
+{
+    rate_targets targets;
+    if (!_rate_targets_published.read(targets) || !is_positive(dt)) {
+        return false;
+    }
+
+    rate_lock();
+
+    // the rate PIDs run at the rate of the gyro samples rather than the main loop
+    get_rate_roll_pid().set_dt(dt);
+    get_rate_pitch_pid().set_dt(dt);
+    get_rate_yaw_pid().set_dt(dt);
+
+    rate_controller_run_sample(_ahrs.correct_gyro(ins_gyro, targets.gyro_drift), targets.ang_vel, dt);
+
+    // leave the main loop dt in place for rate_controller_run() and the mode code
+    get_rate_roll_pid().set_dt(_dt);
+    get_rate_pitch_pid().set_dt(_dt);
+    get_rate_yaw_pid().set_dt(_dt);
+
+    rate_unlock();
+    add_rate_output_injection(targets.output_injection);
+    return true;
+}
+
+// Add an offset to the roll, pitch and yaw outputs the rate controller sent to the motors
+void AC_AttitudeControl::add_rate_output_injection(const Vector3f &injection)
+{
+    if (injection.is_zero()) {
+        return;
+    }
+    _motors.set_roll(_motors.get_roll() + injection.x);
+    _motors.set_pitch(_motors.get_pitch() + injection.y);
+    _motors.set_yaw(_motors.get_yaw() + injection.z);
+}
+
 // Run the roll angular velocity PID controller and return the output
 float AC_AttitudeControl::rate_target_to_motor_roll(float rate_actual_rads, float rate_target_rads)
 {
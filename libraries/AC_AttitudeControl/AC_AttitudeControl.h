@@ -8,6 +8,7 @@
 #include <AP_Math/AP_Math.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
 #include <AP_AHRS/AP_AHRS_View.h>
+#include <AP_HAL/utility/DoubleBuffer.h>
 #include <AP_Motors/AP_Motors.h>
 #include <AC_PID/AC_PID.h>
 #include <AC_PID/AC_P.h>
@@ -48,21 +49,7 @@ public:
     AC_AttitudeControl( AP_AHRS_View &ahrs,
                         const AP_Vehicle::MultiCopter &aparm,
                         AP_Motors& motors,
-                        float dt) :
-        _p_angle_roll(AC_ATTITUDE_CONTROL_ANGLE_P),
-        _p_angle_pitch(AC_ATTITUDE_CONTROL_ANGLE_P),
-        _p_angle_yaw(AC_ATTITUDE_CONTROL_ANGLE_P),
-        _dt(dt),
-        _angle_boost(0),
-        _use_sqrt_controller(true),
-        _throttle_rpy_mix_desired(AC_ATTITUDE_CONTROL_THR_MIX_DEFAULT),
-        _throttle_rpy_mix(AC_ATTITUDE_CONTROL_THR_MIX_DEFAULT),
-        _ahrs(ahrs),
-        _aparm(aparm),
-        _motors(motors)
-        {
-            AP_Param::setup_object_defaults(this, var_info);
-        }
+                        float dt);
 
     // Empty destructor to suppress compiler warning
     virtual ~AC_AttitudeControl() {}
@@ -151,7 +138,21 @@ public:
     virtual void input_angle_step_bf_roll_pitch_yaw(float roll_angle_step_bf_cd, float pitch_angle_step_bf_cd, float yaw_angle_step_bf_cd);
 
     // Run angular velocity controller and send outputs to the motors
-    virtual void rate_controller_run() = 0;
+    void rate_controller_run();
+
+    // Publish the angular velocity targets for rate_controller_run_gyro(), called
+    // by the main loop after the attitude controllers have run
+    void publish_rate_targets();
+
+    // Run angular velocity controller on a gyro sample from the INS, covering dt seconds,
+    // using the last published targets, and send outputs to the motors. This is for a
+    // rate loop thread running apart from the main loop. Returns false if no targets
+    // have been published yet
+    bool rate_controller_run_gyro(const Vector3f &ins_gyro, float dt);
+
+    // Set an offset added to the roll, pitch and yaw outputs of the rate controller, in the
+    // -1 ~ +1 range of the motors inputs. This is for injecting signals for system identification
+    void set_rate_output_injection(const Vector3f &injection) { _rate_output_injection = injection; }
 
     // Convert a 321-intrinsic euler angle derivative to an angular velocity vector
     void euler_rate_to_ang_vel(const Vector3f& euler_rad, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads);
@@ -296,6 +297,13 @@ public:
 
 protected:
 
+    // Run angular velocity controller on a body-frame gyro sample in radians/s, with
+    // targets in radians/s and a time step of dt seconds, and send outputs to the motors
+    virtual void rate_controller_run_sample(const Vector3f &gyro_rads, const Vector3f &rate_target_rads, float dt) = 0;
+
+    // Add an offset to the roll, pitch and yaw outputs the rate controller sent to the motors
+    void add_rate_output_injection(const Vector3f &injection);
+
     // Update rate_target_ang_vel using attitude_error_rot_vec_rad
     Vector3f update_ang_vel_target_from_att_error(Vector3f attitude_error_rot_vec_rad);
 
@@ -374,6 +382,35 @@ protected:
     // velocity controller.
     Vector3f            _rate_target_ang_vel;
 
+    // The angular velocity targets and gyro drift estimate published to a rate loop thread
+    struct rate_targets {
+        Vector3f        ang_vel;
+        Vector3f        gyro_drift;
+        Vector3f        output_injection;
+    };
+    DoubleBuffer<rate_targets> _rate_targets_published;
+
+    // Held while the rate PIDs are run or reset, so a rate loop thread and the main
+    // loop do not change them together. Created in the constructor
+    AP_HAL::Semaphore  *_rate_sem;
+
+    void rate_lock(void) const {
+        if (_rate_sem != nullptr) {
+            _rate_sem->take_blocking();
+        }
+    }
+    void rate_unlock(void) const {
+        if (_rate_sem != nullptr) {
+            _rate_sem->give();
+        }
+    }
+
+    // reset the rate PID integrators, the caller must hold the rate lock
+    void reset_rate_controller_I_terms_locked();
+
+    // Offset added to the roll, pitch and yaw outputs of the rate controller
+    Vector3f            _rate_output_injection;
+
     // This represents a quaternion attitude error in the body frame, used for inertial frame reset handling.
     Quaternion          _attitude_ang_error;
 
@@ -409,7 +446,7 @@ protected:
     /*
       state of control monitoring
     */
-    struct {
+    struct control_monitor_state {
         float rms_roll_P;
         float rms_roll_D;
         float rms_pitch_P;
@@ -244,24 +244,32 @@ void AC_AttitudeControl_Heli::input_rate_bf_roll_pitch_yaw(float roll_rate_bf_cd
 // rate controller (body-frame) methods
 //
 
-// rate_controller_run - run lowest level rate controller and send outputs to the motors
+// rate_controller_run_sample - run lowest level rate controller on a gyro sample and send outputs to the motors
 // should be called at 100hz or more
-void AC_AttitudeControl_Heli::rate_controller_run()
-{	
-    Vector3f gyro_latest = _ahrs.get_gyro_latest();
+void AC_AttitudeControl_Heli::rate_controller_run_sample(const Vector3f &gyro_rads, const Vector3f &rate_target_rads, float dt)
+{
+    // run the rate PIDs of the axes that are not passed through in one pass
+    uint8_t run_mask = 0;
+    if (!_flags_heli.flybar_passthrough) {
+        run_mask |= (1U << AC_HELI_PID_Bank::AXIS_ROLL) | (1U << AC_HELI_PID_Bank::AXIS_PITCH);
+    }
+    if (!_flags_heli.tail_passthrough) {
+        run_mask |= 1U << AC_HELI_PID_Bank::AXIS_YAW;
+    }
+    rate_pids_update(rate_target_rads, gyro_rads, run_mask, dt);
 
-    // call rate controllers and send output to motors object
+    // send output to motors object
     // if using a flybar passthrough roll and pitch directly to motors
     if (_flags_heli.flybar_passthrough) {
         _motors.set_roll(_passthrough_roll/4500.0f);
         _motors.set_pitch(_passthrough_pitch/4500.0f);
     } else {
-        rate_bf_to_motor_roll_pitch(gyro_latest, _rate_target_ang_vel.x, _rate_target_ang_vel.y);
+        rate_bf_to_motor_roll_pitch(gyro_rads, dt);
     }
     if (_flags_heli.tail_passthrough) {
         _motors.set_yaw(_passthrough_yaw/4500.0f);
     } else {
-        _motors.set_yaw(rate_target_to_motor_yaw(gyro_latest.z, _rate_target_ang_vel.z));
+        _motors.set_yaw(rate_pids_to_motor_yaw(dt));
     }
 }
 
@@ -280,55 +288,50 @@ void AC_AttitudeControl_Heli::update_althold_lean_angle_max(float throttle_in)
 // body-frame rate controller
 //
 
-// rate_bf_to_motor_roll_pitch - ask the rate controller to calculate the motor outputs to achieve the target rate in radians/second
-void AC_AttitudeControl_Heli::rate_bf_to_motor_roll_pitch(const Vector3f &rate_rads, float rate_roll_target_rads, float rate_pitch_target_rads)
+// rate_pids_update - run the rate PIDs of the axes in run_mask together
+void AC_AttitudeControl_Heli::rate_pids_update(const Vector3f &rate_target_rads, const Vector3f &rate_rads, uint8_t run_mask, float dt)
+{
+    // i terms are only updated while limited if that will reduce them
+    uint8_t limit_mask = 0;
+    if (_limit_heli.limit_roll) {
+        limit_mask |= 1U << AC_HELI_PID_Bank::AXIS_ROLL;
+    }
+    if (_limit_heli.limit_pitch) {
+        limit_mask |= 1U << AC_HELI_PID_Bank::AXIS_PITCH;
+    }
+    if (_limit_heli.limit_yaw) {
+        limit_mask |= 1U << AC_HELI_PID_Bank::AXIS_YAW;
+    }
+
+    uint8_t leak_mask = 0;
+    if (_flags_heli.leaky_i) {
+        leak_mask |= (1U << AC_HELI_PID_Bank::AXIS_ROLL) | (1U << AC_HELI_PID_Bank::AXIS_PITCH);
+    }
+    if (!((AP_MotorsHeli&)_motors).rotor_runup_complete()) {
+        // If motor is not running use leaky I-term to avoid excessive build-up
+        leak_mask |= 1U << AC_HELI_PID_Bank::AXIS_YAW;
+    }
+
+    // the leak rate is per main loop, so scale it when the rate controller runs at another rate
+    const float leak_rate = AC_ATTITUDE_HELI_RATE_INTEGRATOR_LEAK_RATE * (is_positive(_dt) ? dt / _dt : 1.0f);
+    _pid_rate_bank.update(rate_target_rads, rate_rads, run_mask, limit_mask, leak_mask, leak_rate);
+}
+
+// rate_bf_to_motor_roll_pitch - calculate the motor outputs to achieve the target rate in radians/second from the last rate_pids_update
+void AC_AttitudeControl_Heli::rate_bf_to_motor_roll_pitch(const Vector3f &rate_rads, float dt)
 {
     float roll_pd, roll_i, roll_ff;             // used to capture pid values
     float pitch_pd, pitch_i, pitch_ff;          // used to capture pid values
-    float rate_roll_error_rads, rate_pitch_error_rads;    // simply target_rate - current_rate
     float roll_out, pitch_out;
 
-    // calculate error
-    rate_roll_error_rads = rate_roll_target_rads - rate_rads.x;
-    rate_pitch_error_rads = rate_pitch_target_rads - rate_rads.y;
-
-    // pass error to PID controller
-    _pid_rate_roll.set_input_filter_all(rate_roll_error_rads);
-    _pid_rate_roll.set_desired_rate(rate_roll_target_rads);
-    _pid_rate_pitch.set_input_filter_all(rate_pitch_error_rads);
-    _pid_rate_pitch.set_desired_rate(rate_pitch_target_rads);
-
-    // call p and d controllers
-    roll_pd = _pid_rate_roll.get_p() + _pid_rate_roll.get_d();
-    pitch_pd = _pid_rate_pitch.get_p() + _pid_rate_pitch.get_d();
-
-    // get roll i term
-    roll_i = _pid_rate_roll.get_integrator();
-
-    // update i term as long as we haven't breached the limits or the I term will certainly reduce
-    if (!_flags_heli.limit_roll || ((roll_i>0&&rate_roll_error_rads<0)||(roll_i<0&&rate_roll_error_rads>0))){
-		if (_flags_heli.leaky_i){
-			roll_i = _pid_rate_roll.get_leaky_i(AC_ATTITUDE_HELI_RATE_INTEGRATOR_LEAK_RATE);
-		}else{
-			roll_i = _pid_rate_roll.get_i();
-		}
-    }
-
-    // get pitch i term
-    pitch_i = _pid_rate_pitch.get_integrator();
+    roll_pd = _pid_rate_bank.get_pd(AC_HELI_PID_Bank::AXIS_ROLL);
+    pitch_pd = _pid_rate_bank.get_pd(AC_HELI_PID_Bank::AXIS_PITCH);
+    roll_i = _pid_rate_bank.get_i(AC_HELI_PID_Bank::AXIS_ROLL);
+    pitch_i = _pid_rate_bank.get_i(AC_HELI_PID_Bank::AXIS_PITCH);
 
-    // update i term as long as we haven't breached the limits or the I term will certainly reduce
-    if (!_flags_heli.limit_pitch || ((pitch_i>0&&rate_pitch_error_rads<0)||(pitch_i<0&&rate_pitch_error_rads>0))){
-		if (_flags_heli.leaky_i) {
-			pitch_i = _pid_rate_pitch.get_leaky_i(AC_ATTITUDE_HELI_RATE_INTEGRATOR_LEAK_RATE);
-		}else{
-			pitch_i = _pid_rate_pitch.get_i();
-		}
-    }
-    
     // For legacy reasons, we convert to centi-degrees before inputting to the feedforward
-    roll_ff = roll_feedforward_filter.apply(_pid_rate_roll.get_ff(rate_roll_target_rads), _dt);
-    pitch_ff = pitch_feedforward_filter.apply(_pid_rate_pitch.get_ff(rate_pitch_target_rads), _dt);
+    roll_ff = roll_feedforward_filter.apply(_pid_rate_bank.get_ff(AC_HELI_PID_Bank::AXIS_ROLL), dt);
+    pitch_ff = pitch_feedforward_filter.apply(_pid_rate_bank.get_ff(AC_HELI_PID_Bank::AXIS_PITCH), dt);
 
     // add feed forward and final output
     roll_out = roll_pd + roll_i + roll_ff;
@@ -337,15 +340,15 @@ void AC_AttitudeControl_Heli::rate_bf_to_motor_roll_pitch(const Vector3f &rate_r
     // constrain output and update limit flags
     if (fabsf(roll_out) > AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX) {
         roll_out = constrain_float(roll_out,-AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX,AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX);
-        _flags_heli.limit_roll = true;
+        _limit_heli.limit_roll = true;
     }else{
-        _flags_heli.limit_roll = false;
+        _limit_heli.limit_roll = false;
     }
     if (fabsf(pitch_out) > AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX) {
         pitch_out = constrain_float(pitch_out,-AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX,AC_ATTITUDE_RATE_RP_CONTROLLER_OUT_MAX);
-        _flags_heli.limit_pitch = true;
+        _limit_heli.limit_pitch = true;
     }else{
-        _flags_heli.limit_pitch = false;
+        _limit_heli.limit_pitch = false;
     }
 
     // output to motors
@@ -364,8 +367,8 @@ void AC_AttitudeControl_Heli::rate_bf_to_motor_roll_pitch(const Vector3f &rate_r
         piro_pitch_i = pitch_i;
 
         Vector2f yawratevector;
-        yawratevector.x     = cosf(-rate_rads.z * _dt);
-        yawratevector.y     = sinf(-rate_rads.z * _dt);
+        yawratevector.x     = cosf(-rate_rads.z * dt);
+        yawratevector.y     = sinf(-rate_rads.z * dt);
         yawratevector.normalize();
 
         roll_i      = piro_roll_i * yawratevector.x - piro_pitch_i * yawratevector.y;
@@ -377,37 +380,25 @@ void AC_AttitudeControl_Heli::rate_bf_to_motor_roll_pitch(const Vector3f &rate_r
 
 }
 
-// rate_bf_to_motor_yaw - ask the rate controller to calculate the motor outputs to achieve the target rate in radians/second
+// rate_target_to_motor_yaw - ask the rate controller to calculate the motor outputs to achieve the target rate in radians/second
 float AC_AttitudeControl_Heli::rate_target_to_motor_yaw(float rate_yaw_actual_rads, float rate_target_rads)
+{
+    rate_pids_update(Vector3f(0.0f, 0.0f, rate_target_rads), Vector3f(0.0f, 0.0f, rate_yaw_actual_rads),
+                     1U << AC_HELI_PID_Bank::AXIS_YAW, _dt);
+    return rate_pids_to_motor_yaw(_dt);
+}
+
+// rate_pids_to_motor_yaw - calculate the motor output for yaw from the last rate_pids_update
+float AC_AttitudeControl_Heli::rate_pids_to_motor_yaw(float dt)
 {
     float pd,i,vff;     // used to capture pid values for logging
-    float rate_error_rads;       // simply target_rate - current_rate
     float yaw_out;
 
-    // calculate error and call pid controller
-    rate_error_rads  = rate_target_rads - rate_yaw_actual_rads;
-
-    // pass error to PID controller
-    _pid_rate_yaw.set_input_filter_all(rate_error_rads);
-    _pid_rate_yaw.set_desired_rate(rate_target_rads);
-
-    // get p and d
-    pd = _pid_rate_yaw.get_p() + _pid_rate_yaw.get_d();
+    pd = _pid_rate_bank.get_pd(AC_HELI_PID_Bank::AXIS_YAW);
+    i = _pid_rate_bank.get_i(AC_HELI_PID_Bank::AXIS_YAW);
 
-    // get i term
-    i = _pid_rate_yaw.get_integrator();
-
-    // update i term as long as we haven't breached the limits or the I term will certainly reduce
-    if (!_flags_heli.limit_yaw || ((i>0&&rate_error_rads<0)||(i<0&&rate_error_rads>0))) {
-        if (((AP_MotorsHeli&)_motors).rotor_runup_complete()) {
-            i = _pid_rate_yaw.get_i();
-        } else {
-            i = ((AC_HELI_PID&)_pid_rate_yaw).get_leaky_i(AC_ATTITUDE_HELI_RATE_INTEGRATOR_LEAK_RATE);    // If motor is not running use leaky I-term to avoid excessive build-up
-        }
-    }
-    
     // For legacy reasons, we convert to centi-degrees before inputting to the feedforward
-    vff = yaw_velocity_feedforward_filter.apply(_pid_rate_yaw.get_ff(rate_target_rads), _dt);
+    vff = yaw_velocity_feedforward_filter.apply(_pid_rate_bank.get_ff(AC_HELI_PID_Bank::AXIS_YAW), dt);
     
     // add feed forward
     yaw_out = pd + i + vff;
@@ -415,9 +406,9 @@ float AC_AttitudeControl_Heli::rate_target_to_motor_yaw(float rate_yaw_actual_ra
     // constrain output and update limit flag
     if (fabsf(yaw_out) > AC_ATTITUDE_RATE_YAW_CONTROLLER_OUT_MAX) {
         yaw_out = constrain_float(yaw_out,-AC_ATTITUDE_RATE_YAW_CONTROLLER_OUT_MAX,AC_ATTITUDE_RATE_YAW_CONTROLLER_OUT_MAX);
-        _flags_heli.limit_yaw = true;
+        _limit_heli.limit_yaw = true;
     }else{
-        _flags_heli.limit_yaw = false;
+        _limit_heli.limit_yaw = false;
     }
 
     // output to motors
@@ -6,6 +6,7 @@
 #include "AC_AttitudeControl.h"
 #include <AP_Motors/AP_MotorsHeli.h>
 #include <AC_PID/AC_HELI_PID.h>
+#include <AC_PID/AC_HELI_PID_Bank.h>
 #include <Filter/Filter.h>
 
 // default rate controller PID gains
@@ -40,6 +41,7 @@ public:
         _pid_rate_roll(AC_ATC_HELI_RATE_RP_P, AC_ATC_HELI_RATE_RP_I, AC_ATC_HELI_RATE_RP_D, AC_ATC_HELI_RATE_RP_IMAX, AC_ATC_HELI_RATE_RP_FILT_HZ, dt, AC_ATC_HELI_RATE_RP_FF),
         _pid_rate_pitch(AC_ATC_HELI_RATE_RP_P, AC_ATC_HELI_RATE_RP_I, AC_ATC_HELI_RATE_RP_D, AC_ATC_HELI_RATE_RP_IMAX, AC_ATC_HELI_RATE_RP_FILT_HZ, dt, AC_ATC_HELI_RATE_RP_FF),
         _pid_rate_yaw(AC_ATC_HELI_RATE_YAW_P, AC_ATC_HELI_RATE_YAW_I, AC_ATC_HELI_RATE_YAW_D, AC_ATC_HELI_RATE_YAW_IMAX, AC_ATC_HELI_RATE_YAW_FILT_HZ, dt, AC_ATC_HELI_RATE_YAW_FF),
+        _pid_rate_bank(_pid_rate_roll, _pid_rate_pitch, _pid_rate_yaw),
         pitch_feedforward_filter(AC_ATTITUDE_HELI_RATE_RP_FF_FILTER),
         roll_feedforward_filter(AC_ATTITUDE_HELI_RATE_RP_FF_FILTER),
         yaw_velocity_feedforward_filter(AC_ATTITUDE_HELI_RATE_Y_VFF_FILTER)
@@ -47,9 +49,9 @@ public:
             AP_Param::setup_object_defaults(this, var_info);
 
             // initialise flags
-            _flags_heli.limit_roll = false;
-            _flags_heli.limit_pitch = false;
-            _flags_heli.limit_yaw = false;
+            _limit_heli.limit_roll = false;
+            _limit_heli.limit_pitch = false;
+            _limit_heli.limit_yaw = false;
             _flags_heli.leaky_i = true;
             _flags_heli.flybar_passthrough = false;
             _flags_heli.tail_passthrough = false;
@@ -70,10 +72,6 @@ public:
     // subclass non-passthrough too, for external gyro, no flybar
     void input_rate_bf_roll_pitch_yaw(float roll_rate_bf_cds, float pitch_rate_bf_cds, float yaw_rate_bf_cds) override;
 
-	// rate_controller_run - run lowest level body-frame rate controller and send outputs to the motors
-	// should be called at 100hz or more
-	virtual void rate_controller_run();
-
     // Update Alt_Hold angle maximum
     void update_althold_lean_angle_max(float throttle_in) override;
 
@@ -108,10 +106,15 @@ public:
 private:
 
     // To-Do: move these limits flags into the heli motors class
-    struct AttControlHeliFlags {
+    // they are set by the rate controller, which may run in a rate loop thread,
+    // so are kept apart from the flags set by the main loop
+    struct AttControlHeliLimitFlags {
         uint8_t limit_roll          :   1;  // 1 if we have requested larger roll angle than swash can physically move
         uint8_t limit_pitch         :   1;  // 1 if we have requested larger pitch angle than swash can physically move
         uint8_t limit_yaw           :   1;  // 1 if we have requested larger yaw angle than tail servo can physically move
+    } _limit_heli;
+
+    struct AttControlHeliFlags {
         uint8_t leaky_i             :   1;  // 1 if we should use leaky i term for body-frame rate to motor stage
         uint8_t flybar_passthrough  :   1;  // 1 if we should pass through pilots roll & pitch input directly to swash-plate
         uint8_t tail_passthrough    :   1;  // 1 if we should pass through pilots yaw input to tail
@@ -121,9 +124,18 @@ private:
     //
     // body-frame rate controller
     //
-	// rate_bf_to_motor_roll_pitch - ask the rate controller to calculate the motor outputs to achieve the target body-frame rate (in radians/sec) for roll, pitch and yaw
+    // rate_controller_run_sample - run lowest level body-frame rate controller on a gyro sample and send outputs to the motors
+    // should be called at 100hz or more
+    void rate_controller_run_sample(const Vector3f &gyro_rads, const Vector3f &rate_target_rads, float dt) override;
+
+    // rate_pids_update - run the rate PIDs of the axes in run_mask together, applying the limit and leaky i flags
+    void rate_pids_update(const Vector3f &rate_target_rads, const Vector3f &rate_rads, uint8_t run_mask, float dt);
+
+	// rate_bf_to_motor_roll_pitch - calculate the motor outputs for roll and pitch from the last rate_pids_update
     // outputs are sent directly to motor class
-    void rate_bf_to_motor_roll_pitch(const Vector3f &rate_rads, float rate_roll_target_rads, float rate_pitch_target_rads);
+    void rate_bf_to_motor_roll_pitch(const Vector3f &rate_rads, float dt);
+    // rate_pids_to_motor_yaw - calculate the motor output for yaw from the last rate_pids_update
+    float rate_pids_to_motor_yaw(float dt);
     float rate_target_to_motor_yaw(float rate_yaw_actual_rads, float rate_yaw_rads) override;
 
     //
@@ -155,6 +167,7 @@ private:
     AC_HELI_PID     _pid_rate_roll;
     AC_HELI_PID     _pid_rate_pitch;
     AC_HELI_PID     _pid_rate_yaw;
+    AC_HELI_PID_Bank _pid_rate_bank;               // runs the three rate PIDs together
     
     // LPF filters to act on Rate Feedforward terms to linearize output.
     // Due to complicated aerodynamic effects, feedforwards acting too fast can lead
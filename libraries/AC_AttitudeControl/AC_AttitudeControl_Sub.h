@@ -54,9 +54,6 @@ public:
     // are we producing min throttle?
     bool is_throttle_mix_min() const override { return (_throttle_rpy_mix < 1.25f*_thr_mix_min); }
 
-    // run lowest level body-frame rate controller and send outputs to the motors
-    void rate_controller_run();
-
     // sanity check parameters.  should be called once before take-off
     void parameter_sanity_check();
 
@@ -65,8 +62,11 @@ public:
 
 protected:
 
-    // update_throttle_rpy_mix - updates thr_low_comp value towards the target
-    void update_throttle_rpy_mix();
+    // run lowest level body-frame rate controller on a gyro sample and send outputs to the motors
+    void rate_controller_run_sample(const Vector3f &gyro_rads, const Vector3f &rate_target_rads, float dt) override;
+
+    // update_throttle_rpy_mix - updates thr_low_comp value towards the target over dt seconds
+    void update_throttle_rpy_mix(float dt);
 
     // get maximum value throttle can be raised to based on throttle vs attitude prioritisation
     float get_throttle_avg_max(float throttle_in);
@@ -41,13 +41,18 @@ void AC_AttitudeControl::control_monitor_update(void)
  */
 void AC_AttitudeControl::control_monitor_log(void)
 {
-    DataFlash_Class::instance()->Log_Write("CTRL", "TimeUS,RMSRollP,RMSRollD,RMSPitchP,RMSPitchD,RMSYaw", "Qfffff",
-                                           AP_HAL::micros64(),
-                                           (double)sqrtf(_control_monitor.rms_roll_P),
-                                           (double)sqrtf(_control_monitor.rms_roll_D),
-                                           (double)sqrtf(_control_monitor.rms_pitch_P),
-                                           (double)sqrtf(_control_monitor.rms_pitch_D),
-                                           (double)sqrtf(_control_monitor.rms_yaw));
+    // a rate loop thread updates the state along with the rate PIDs
+    rate_lock();
+    const control_monitor_state state = _control_monitor;
+    rate_unlock();
+
+    DataFlash_Class::instance()->Log_Write_Typed("CTRL", "TimeUS,RMSRollP,RMSRollD,RMSPitchP,RMSPitchD,RMSYaw",
+                                                 AP_HAL::micros64(),
+                                                 sqrtf(state.rms_roll_P),
+                                                 sqrtf(state.rms_roll_D),
+                                                 sqrtf(state.rms_pitch_P),
+                                                 sqrtf(state.rms_pitch_D),
+                                                 sqrtf(state.rms_yaw));
 
 }
 
@@ -56,7 +61,10 @@ void AC_AttitudeControl::control_monitor_log(void)
  */
 float AC_AttitudeControl::control_monitor_rms_output_roll(void) const
 {
-    return sqrtf(_control_monitor.rms_roll_P + _control_monitor.rms_roll_D);
+    rate_lock();
+    const float rms = _control_monitor.rms_roll_P + _control_monitor.rms_roll_D;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -64,7 +72,10 @@ float AC_AttitudeControl::control_monitor_rms_output_roll(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_roll_P(void) const
 {
-    return sqrtf(_control_monitor.rms_roll_P);
+    rate_lock();
+    const float rms = _control_monitor.rms_roll_P;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -72,7 +83,10 @@ float AC_AttitudeControl::control_monitor_rms_output_roll_P(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_roll_D(void) const
 {
-    return sqrtf(_control_monitor.rms_roll_D);
+    rate_lock();
+    const float rms = _control_monitor.rms_roll_D;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -80,7 +94,10 @@ float AC_AttitudeControl::control_monitor_rms_output_roll_D(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_pitch(void) const
 {
-    return sqrtf(_control_monitor.rms_pitch_P + _control_monitor.rms_pitch_D);
+    rate_lock();
+    const float rms = _control_monitor.rms_pitch_P + _control_monitor.rms_pitch_D;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -88,7 +105,10 @@ float AC_AttitudeControl::control_monitor_rms_output_pitch(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_pitch_P(void) const
 {
-    return sqrtf(_control_monitor.rms_pitch_P);
+    rate_lock();
+    const float rms = _control_monitor.rms_pitch_P;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -96,7 +116,10 @@ float AC_AttitudeControl::control_monitor_rms_output_pitch_P(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_pitch_D(void) const
 {
-    return sqrtf(_control_monitor.rms_pitch_D);
+    rate_lock();
+    const float rms = _control_monitor.rms_pitch_D;
+    rate_unlock();
+    return sqrtf(rms);
 }
 
 /*
@@ -104,5 +127,8 @@ float AC_AttitudeControl::control_monitor_rms_output_pitch_D(void) const
  */
 float AC_AttitudeControl::control_monitor_rms_output_yaw(void) const
 {
-    return sqrtf(_control_monitor.rms_yaw);
+    rate_lock();
+    const float rms = _control_monitor.rms_yaw;
+    rate_unlock();
+    return sqrtf(rms);
 }
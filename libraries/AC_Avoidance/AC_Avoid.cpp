@@ -344,7 +344,7 @@ void AC_Avoid::adjust_velocity_polygon_fence(float kP, float accel_cmss, Vector2
     const Vector2f* boundary = _fence.get_polygon_points(num_points);
 
     // adjust velocity using polygon
-    adjust_velocity_polygon(kP, accel_cmss, desired_vel_cms, boundary, num_points, true, _fence.get_margin(), dt);
+    adjust_velocity_polygon(kP, accel_cmss, desired_vel_cms, boundary, num_points, true, _fence.get_margin(), dt, _fence.get_polygon_index());
 }
 
 /*
@@ -397,7 +397,7 @@ void AC_Avoid::adjust_velocity_proximity(float kP, float accel_cmss, Vector2f &d
 /*
  * Adjusts the desired velocity for the polygon fence.
  */
-void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &desired_vel_cms, const Vector2f* boundary, uint16_t num_points, bool earth_frame, float margin, float dt)
+void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &desired_vel_cms, const Vector2f* boundary, uint16_t num_points, bool earth_frame, float margin, float dt, const AP_PolygonIndex* index)
 {
     // exit if there are no points
     if (boundary == nullptr || num_points == 0) {
@@ -415,7 +415,11 @@ void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &des
         position_xy = position_xy * 100.0f;  // m to cm
     }
 
-    if (_fence.boundary_breached(position_xy, num_points, boundary)) {
+    if (index != nullptr) {
+        if (index->outside(position_xy)) {
+            return;
+        }
+    } else if (_fence.boundary_breached(position_xy, num_points, boundary)) {
         return;
     }
 
@@ -437,8 +441,39 @@ void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &des
     const float speed = safe_vel.length();
     const Vector2f stopping_point_plus_margin = position_xy + safe_vel*((2.0f + margin_cm + get_stopping_distance(kP, accel_cmss, speed))/speed);
 
+    // use the index to find the edges close enough to limit the velocity
+    AP_PolygonIndex::EdgeSet nearby_edges;
+    bool use_index = false;
+    if (index != nullptr) {
+        Vector2f query_min, query_max;
+        if ((AC_Avoid::BehaviourType)_behavior.get() == BEHAVIOR_SLIDE) {
+            // an edge further away than the stopping distance (or one
+            // step at the current speed) plus the margin leaves a maximum
+            // speed above the current speed
+            if (is_positive(accel_cmss) && !is_negative(kP)) {
+                const float range = 2.0f + margin_cm + MAX(get_stopping_distance(kP, accel_cmss, speed), speed * dt);
+                query_min = position_xy - Vector2f(range, range);
+                query_max = position_xy + Vector2f(range, range);
+                use_index = true;
+            }
+        } else {
+            // only edges crossing the line to the stopping point can intersect it
+            query_min.x = MIN(position_xy.x, stopping_point_plus_margin.x) - 1.0f;
+            query_min.y = MIN(position_xy.y, stopping_point_plus_margin.y) - 1.0f;
+            query_max.x = MAX(position_xy.x, stopping_point_plus_margin.x) + 1.0f;
+            query_max.y = MAX(position_xy.y, stopping_point_plus_margin.y) + 1.0f;
+            use_index = true;
+        }
+        if (use_index && index->edges_in_box(query_min, query_max, nearby_edges) == 0) {
+            return;
+        }
+    }
+
     uint16_t i, j;
     for (i = 0, j = num_points-1; i < num_points; j = i++) {
+        if (use_index && (nearby_edges.bits[i / 32] & (1U << (i % 32))) == 0) {
+            continue;
+        }
         // end points of current edge
         Vector2f start = boundary[j];
         Vector2f end = boundary[i];
@@ -249,7 +249,7 @@ bool AC_Fence::check_fence_polygon()
     }
 
     position = position * 100.0f;  // m to cm
-    if (_poly_loader.boundary_breached(position, _boundary_num_points, _boundary, true)) {
+    if (polygon_breached(position)) {
         // check if this is a new breach
         if (_breached_fences & AC_FENCE_TYPE_POLYGON) {
             // not a new breach
@@ -377,7 +377,7 @@ bool AC_Fence::check_destination_within_fence(const Location_Class& loc)
         // check ekf has a good location
         Vector2f posNE;
         if (loc.get_vector_xy_from_origin_NE(posNE)) {
-            if (_poly_loader.boundary_breached(posNE, _boundary_num_points, _boundary, true)) {
+            if (polygon_breached(posNE)) {
                 return false;
             }
         }
@@ -463,6 +463,15 @@ bool AC_Fence::boundary_breached(const Vector2f& location, uint16_t num_points,
     return _poly_loader.boundary_breached(location, num_points, points, true);
 }
 
+/// polygon_breached - true if location (offset from ekf origin in cm) is outside the loaded polygon boundary
+bool AC_Fence::polygon_breached(const Vector2f& location) const
+{
+    if (_boundary_index.valid()) {
+        return _boundary_index.outside(location);
+    }
+    return _poly_loader.boundary_breached(location, _boundary_num_points, _boundary, true);
+}
+
 /// handler for polygon fence messages with GCS
 void AC_Fence::handle_msg(GCS_MAVLINK &link, mavlink_message_t* msg)
 {
@@ -558,6 +567,11 @@ bool AC_Fence::load_polygon_from_eeprom(bool force_reload)
     // update validity of polygon
     _boundary_valid = _poly_loader.boundary_valid(_boundary_num_points, _boundary, true);
 
+    // index the boundary so breach checks and avoidance only visit nearby edges
+    if (!_boundary_valid || !_boundary_index.build(&_boundary[1], _boundary_num_points - 1)) {
+        _boundary_index.clear();
+    }
+
     return true;
 }
 
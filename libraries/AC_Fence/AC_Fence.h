@@ -103,6 +103,9 @@ public:
     /// returns true if we've breached the polygon boundary.  simple passthrough to underlying _poly_loader object
     bool boundary_breached(const Vector2f& location, uint16_t num_points, const Vector2f* points) const;
 
+    /// returns the spatial index of the points returned by get_polygon_points, or nullptr if the boundary is not indexed
+    const AP_PolygonIndex* get_polygon_index() const { return _boundary_index.valid() ? &_boundary_index : nullptr; }
+
     /// handler for polygon fence messages with GCS
     void handle_msg(GCS_MAVLINK &link, mavlink_message_t* msg);
 
@@ -138,6 +141,9 @@ private:
     /// load polygon points stored in eeprom into boundary array and perform validation.  returns true if load successfully completed
     bool load_polygon_from_eeprom(bool force_reload = false);
 
+    /// polygon_breached - true if location (offset from ekf origin in cm) is outside the loaded polygon boundary
+    bool polygon_breached(const Vector2f& location) const;
+
     // pointers to other objects we depend upon
     const AP_AHRS_NavEKF& _ahrs;
 
@@ -178,4 +184,5 @@ private:
     bool            _boundary_create_attempted = false; // true if we have attempted to create the boundary array
     bool            _boundary_loaded = false;       // true if boundary array has been loaded from eeprom
     bool            _boundary_valid = false;        // true if boundary forms a closed polygon
+    AP_PolygonIndex _boundary_index;                // spatial index of the boundary (excluding the return point), built when the boundary is loaded
 };
@@ -14,6 +14,8 @@
 /// @class	AC_HELI_PID
 /// @brief	Heli PID control class
 class AC_HELI_PID : public AC_PID {
+    friend class AC_HELI_PID_Bank;
+
 public:
 
     /// Constructor for PID
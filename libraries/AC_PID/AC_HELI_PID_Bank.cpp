@@ -0,0 +1,137 @@
+/// @file	AC_HELI_PID_Bank.cpp
+/// @brief	Runs the helicopter roll, pitch and yaw rate PIDs together
+
+#include "AC_HELI_PID_Bank.h"
+
+AC_HELI_PID_Bank::AC_HELI_PID_Bank(AC_HELI_PID &roll, AC_HELI_PID &pitch, AC_HELI_PID &yaw) :
+    _pid{&roll, &pitch, &yaw}
+{
+    for (uint8_t a = 0; a < AXES; a++) {
+        // force the filter alpha to be calculated on the first update
+        _filt_alpha[a] = 1.0f;
+        _filt_alpha_dt[a] = -1.0f;
+        _filt_alpha_hz[a] = -1.0f;
+        _inv_dt[a] = 0.0f;
+        _error[a] = 0.0f;
+        _pd[a] = 0.0f;
+        _i[a] = 0.0f;
+        _ff[a] = 0.0f;
+    }
+}
+
+// update_filt_alpha - recalculate the input filter alpha of an axis if dt or the filter frequency changed
+void AC_HELI_PID_Bank::update_filt_alpha(uint8_t axis)
+{
+    const AC_HELI_PID &pid = *_pid[axis];
+    const float dt = pid._dt;
+    const float filt_hz = pid._filt_hz;
+    if (dt == _filt_alpha_dt[axis] && filt_hz == _filt_alpha_hz[axis]) {
+        return;
+    }
+    _filt_alpha_dt[axis] = dt;
+    _filt_alpha_hz[axis] = filt_hz;
+    _filt_alpha[axis] = pid.get_filt_alpha();
+    _inv_dt[axis] = dt > 0.0f ? 1.0f / dt : 0.0f;
+}
+
+// update - run the PIDs of the axes in run_mask
+//  this follows set_input_filter_all, get_p, get_d, get_ff and get_i or
+//  get_leaky_i of each PID, as called by the heli rate controller
+void AC_HELI_PID_Bank::update(const Vector3f &target, const Vector3f &measurement,
+                              uint8_t run_mask, uint8_t limit_mask, uint8_t leak_mask, float leak_rate)
+{
+    float input[AXES];
+    float derivative[AXES];
+    float integrator[AXES];
+    uint8_t i_updated = 0;
+
+    // gather the state of each axis
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (!(run_mask & (1U << a))) {
+            continue;
+        }
+        AC_HELI_PID &pid = *_pid[a];
+        update_filt_alpha(a);
+        _error[a] = target[a] - measurement[a];
+
+        // reset input filter to the value received, unless it is inf or NaN
+        if (pid._flags._reset_filter && isfinite(_error[a])) {
+            pid._flags._reset_filter = false;
+            pid._input = _error[a];
+            pid._derivative = 0.0f;
+        }
+        input[a] = pid._input;
+        derivative[a] = pid._derivative;
+        integrator[a] = pid._integrator;
+    }
+
+    // update input filter and calculate derivative, not processing inf or NaN
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (!(run_mask & (1U << a)) || !isfinite(_error[a])) {
+            continue;
+        }
+        const float input_filt_change = _filt_alpha[a] * (_error[a] - input[a]);
+        input[a] += input_filt_change;
+        if (_filt_alpha_dt[a] > 0.0f) {
+            derivative[a] = input_filt_change * _inv_dt[a];
+        }
+    }
+
+    // update i term as long as we haven't breached the limits or the I term will certainly reduce
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (!(run_mask & (1U << a))) {
+            continue;
+        }
+        const AC_HELI_PID &pid = *_pid[a];
+        float i = integrator[a];
+        const bool i_reduces = (i > 0 && _error[a] < 0) || (i < 0 && _error[a] > 0);
+        if ((limit_mask & (1U << a)) && !i_reduces) {
+            _i[a] = i;
+            continue;
+        }
+        if (is_zero(pid._ki) || is_zero(pid._dt)) {
+            _i[a] = 0.0f;
+            continue;
+        }
+        if (leak_mask & (1U << a)) {
+            // integrator does not leak down below Leak Min
+            const float leak_min = pid._leak_min;
+            if (i > leak_min) {
+                i -= (i - leak_min) * leak_rate;
+            } else if (i < -leak_min) {
+                i -= (i + leak_min) * leak_rate;
+            }
+        }
+        i += (input[a] * pid._ki) * pid._dt;
+        const float imax = pid._imax;
+        if (i < -imax) {
+            i = -imax;
+        } else if (i > imax) {
+            i = imax;
+        }
+        integrator[a] = i;
+        _i[a] = i;
+        i_updated |= 1U << a;
+    }
+
+    // write the state back and calculate the p, d and feedforward terms
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (!(run_mask & (1U << a))) {
+            continue;
+        }
+        AC_HELI_PID &pid = *_pid[a];
+        if (i_updated & (1U << a)) {
+            pid._pid_info.I = integrator[a];
+        }
+        pid._input = input[a];
+        pid._derivative = derivative[a];
+        pid._integrator = integrator[a];
+
+        pid._pid_info.desired = target[a];
+        pid._pid_info.P = input[a] * pid._kp;
+        pid._pid_info.D = pid._kd * derivative[a];
+        pid._pid_info.FF = target[a] * pid._ff;
+        _pd[a] = pid._pid_info.P + pid._pid_info.D;
+        _ff[a] = pid._pid_info.FF;
+    }
+}
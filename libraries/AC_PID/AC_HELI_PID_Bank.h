@@ -0,0 +1,65 @@
+#pragma once
+
+/// @file	AC_HELI_PID_Bank.h
+/// @brief	Runs the helicopter roll, pitch and yaw rate PIDs together
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+#include "AC_HELI_PID.h"
+
+/// @class	AC_HELI_PID_Bank
+/// @brief	Multi-axis update for a set of helicopter rate PIDs
+///
+/// Gains, integrators and filter state stay in the AC_HELI_PID objects, so
+/// parameters, autotune, logging and resets of the individual PIDs work as
+/// before. Each update gathers the state of all axes into arrays, steps them
+/// together and writes them back, with the input filter coefficients cached
+/// until dt or the filter frequency of an axis changes.
+class AC_HELI_PID_Bank {
+public:
+
+    enum axis {
+        AXIS_ROLL = 0,
+        AXIS_PITCH,
+        AXIS_YAW,
+        AXES
+    };
+
+    AC_HELI_PID_Bank(AC_HELI_PID &roll, AC_HELI_PID &pitch, AC_HELI_PID &yaw);
+
+    /* Do not allow copies */
+    AC_HELI_PID_Bank(const AC_HELI_PID_Bank &other) = delete;
+    AC_HELI_PID_Bank &operator=(const AC_HELI_PID_Bank&) = delete;
+
+    // update - run the PIDs of the axes in run_mask, with bit n set for axis n
+    //  target and measurement are rates in radians/second
+    //  the integrator of an axis in limit_mask is only updated if that will reduce it
+    //  the integrator of an axis in leak_mask leaks at leak_rate as in AC_HELI_PID::get_leaky_i
+    void        update(const Vector3f &target, const Vector3f &measurement,
+                       uint8_t run_mask, uint8_t limit_mask, uint8_t leak_mask, float leak_rate);
+
+    // results from the last update of an axis
+    float       get_error(uint8_t axis) const { return _error[axis]; }
+    float       get_pd(uint8_t axis) const { return _pd[axis]; }
+    float       get_i(uint8_t axis) const { return _i[axis]; }
+    float       get_ff(uint8_t axis) const { return _ff[axis]; }
+
+private:
+
+    // recalculate the input filter alpha of an axis if dt or the filter frequency changed
+    void        update_filt_alpha(uint8_t axis);
+
+    AC_HELI_PID     *_pid[AXES];
+
+    // cached input filter alpha and the dt and frequency it was calculated for
+    float           _filt_alpha[AXES];
+    float           _filt_alpha_dt[AXES];
+    float           _filt_alpha_hz[AXES];
+    float           _inv_dt[AXES];
+
+    // outputs
+    float           _error[AXES];
+    float           _pd[AXES];
+    float           _i[AXES];
+    float           _ff[AXES];
+};
@@ -15,6 +15,8 @@
 /// @class	AC_PID
 /// @brief	Copter PID control class
 class AC_PID {
+    friend class AC_HELI_PID_Bank;
+
 public:
 
     // Constructor for PID
@@ -754,6 +754,9 @@ bool AC_WPNav::set_spline_origin_and_destination(const Vector3f& origin, const V
         update_spline_solution(origin, destination, _spline_origin_vel, _spline_destination_vel);
     }
 
+    // start from the distance along the new segment matching any overrun from the previous segment
+    _spline_dist = spline_dist_from_time(_spline_time);
+
     // store origin and destination locations
     _origin = origin;
     _destination = destination;
@@ -827,8 +830,70 @@ void AC_WPNav::update_spline_solution(const Vector3f& origin, const Vector3f& de
     _hermite_spline_solution[1] = origin_vel;
     _hermite_spline_solution[2] = -origin*3.0f -origin_vel*2.0f + dest*3.0f - dest_vel;
     _hermite_spline_solution[3] = origin*2.0f + origin_vel -dest*2.0f + dest_vel;
+
+    update_spline_length_table();
  }
 
+/// update_spline_length_table - recalculates the path length at evenly spaced spline times
+///     the path between samples is approximated by straight lines
+void AC_WPNav::update_spline_length_table()
+{
+    Vector3f prev_pos = _hermite_spline_solution[0];
+    Vector3f pos, vel;
+    _spline_length[0] = 0.0f;
+    for (uint8_t i = 1; i < WPNAV_SPLINE_TABLE_SIZE; i++) {
+        calc_spline_pos_vel(i / (float)(WPNAV_SPLINE_TABLE_SIZE - 1), pos, vel);
+        _spline_length[i] = _spline_length[i-1] + (pos - prev_pos).length();
+        prev_pos = pos;
+    }
+}
+
+/// spline_dist_from_time - returns the distance in cm along the spline segment at the given spline time
+float AC_WPNav::spline_dist_from_time(float spline_time) const
+{
+    const float index = constrain_float(spline_time, 0.0f, 1.0f) * (WPNAV_SPLINE_TABLE_SIZE - 1);
+    const uint8_t i = MIN((uint8_t)index, WPNAV_SPLINE_TABLE_SIZE - 2);
+    return _spline_length[i] + (index - i) * (_spline_length[i+1] - _spline_length[i]);
+}
+
+/// spline_time_from_dist - returns the spline time at the given distance in cm along the spline segment
+///     uses a binary search of the path length table so the cost does not depend on the segment length
+float AC_WPNav::spline_time_from_dist(float dist) const
+{
+    const float total_length = _spline_length[WPNAV_SPLINE_TABLE_SIZE - 1];
+    if (dist <= 0.0f) {
+        return 0.0f;
+    }
+    if (dist >= total_length) {
+        // extrapolate past the end of the segment using the velocity at the destination
+        const float end_speed = (_hermite_spline_solution[1] + _hermite_spline_solution[2] * 2.0f + _hermite_spline_solution[3] * 3.0f).length();
+        if (is_zero(end_speed)) {
+            return 1.0f;
+        }
+        return 1.0f + (dist - total_length) / end_speed;
+    }
+
+    // find the last table entry not beyond dist
+    uint8_t low = 0;
+    uint8_t high = WPNAV_SPLINE_TABLE_SIZE - 1;
+    while (high - low > 1) {
+        const uint8_t mid = (low + high) / 2;
+        if (_spline_length[mid] <= dist) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    // interpolate between the two table entries
+    const float seg_length = _spline_length[high] - _spline_length[low];
+    float frac = 0.0f;
+    if (is_positive(seg_length)) {
+        frac = (dist - _spline_length[low]) / seg_length;
+    }
+    return (low + frac) / (WPNAV_SPLINE_TABLE_SIZE - 1);
+}
+
 /// advance_spline_target_along_track - move target location along track from origin to destination
 bool AC_WPNav::advance_spline_target_along_track(float dt)
 {
@@ -901,9 +966,6 @@ bool AC_WPNav::advance_spline_target_along_track(float dt)
         // constrain target velocity
         _spline_vel_scaler = constrain_float(_spline_vel_scaler, 0.0f, vel_limit);
 
-        // scale the spline_time by the velocity we've calculated vs the velocity that came out of the spline calculator
-        _spline_time_scale = _spline_vel_scaler / target_vel_length;
-
         // update target position
         target_pos.z += terr_offset;
         _pos_control.set_pos_target(target_pos);
@@ -925,8 +987,9 @@ bool AC_WPNav::advance_spline_target_along_track(float dt)
             }
         }
 
-        // advance spline time to next step
-        _spline_time += _spline_time_scale*dt;
+        // advance along the path at the velocity we've calculated and look up the matching spline time
+        _spline_dist += _spline_vel_scaler*dt;
+        _spline_time = spline_time_from_dist(_spline_dist);
 
         // we will reach the next waypoint in the next step so set reached_destination flag
         // To-Do: is this one step too early?
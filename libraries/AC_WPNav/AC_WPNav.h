@@ -34,6 +34,8 @@
 
 #define WPNAV_RANGEFINDER_FILT_Z         0.25f      // range finder distance filtered at 0.25hz
 
+#define WPNAV_SPLINE_TABLE_SIZE             33      // number of evenly spaced spline times at which the path length is stored
+
 class AC_WPNav
 {
 public:
@@ -257,6 +259,17 @@ protected:
     /// 	relies on update_spline_solution being called since the previous
     void calc_spline_pos_vel(float spline_time, Vector3f& position, Vector3f& velocity);
 
+    /// update_spline_length_table - recalculates the path length at evenly spaced spline times
+    ///     called by update_spline_solution
+    void update_spline_length_table();
+
+    /// spline_dist_from_time - returns the distance in cm along the spline segment at the given spline time
+    float spline_dist_from_time(float spline_time) const;
+
+    /// spline_time_from_dist - returns the spline time at the given distance in cm along the spline segment
+    ///     distances beyond the end of the segment return spline times above 1
+    float spline_time_from_dist(float dist) const;
+
     // get terrain's altitude (in cm above the ekf origin) at the current position (+ve means terrain below vehicle is above ekf origin's altitude)
     bool get_terrain_offset(float& offset_cm);
 
@@ -302,7 +315,8 @@ protected:
 
     // spline variables
     float       _spline_time;           // current spline time between origin and destination
-    float       _spline_time_scale;     // current spline time between origin and destination
+    float       _spline_dist;           // current distance in cm along the spline path from the origin
+    float       _spline_length[WPNAV_SPLINE_TABLE_SIZE]; // path length in cm from the origin at evenly spaced spline times
     Vector3f    _spline_origin_vel;     // the target velocity vector at the origin of the spline segment
     Vector3f    _spline_destination_vel;// the target velocity vector at the destination point of the spline segment
     Vector3f    _hermite_spline_solution[4]; // array describing spline path between origin and destination
@@ -147,15 +147,30 @@ void AP_ADSB::init(void)
         in_state.list_size = in_state.list_size_param;
         in_state.vehicle_list = new adsb_vehicle_t[in_state.list_size];
 
-        if (in_state.vehicle_list == nullptr) {
+        uint16_t table_size = 1;
+        while (table_size < 2 * in_state.list_size) {
+            table_size <<= 1;
+        }
+        in_state.icao_table = new uint16_t[table_size];
+        in_state.icao_table_mask = table_size - 1;
+        in_state.heap = new uint16_t[in_state.list_size];
+        in_state.heap_pos = new uint16_t[in_state.list_size];
+        in_state.distance = new float[in_state.list_size];
+
+        if (in_state.vehicle_list == nullptr ||
+            in_state.icao_table == nullptr ||
+            in_state.heap == nullptr ||
+            in_state.heap_pos == nullptr ||
+            in_state.distance == nullptr) {
             // dynamic RAM allocation of _vehicle_list[] failed, disable gracefully
             hal.console->printf("Unable to initialize ADS-B vehicle list\n");
+            deinit();
             _enabled.set_and_notify(0);
+            return;
         }
     }
 
-    furthest_vehicle_distance = 0;
-    furthest_vehicle_index = 0;
+    memset(in_state.icao_table, 0, (in_state.icao_table_mask + 1) * sizeof(in_state.icao_table[0]));
 
     // out_state
     set_callsign("PING1234", false);
@@ -171,6 +186,14 @@ void AP_ADSB::deinit(void)
         delete [] in_state.vehicle_list;
         in_state.vehicle_list = nullptr;
     }
+    delete [] in_state.icao_table;
+    in_state.icao_table = nullptr;
+    delete [] in_state.heap;
+    in_state.heap = nullptr;
+    delete [] in_state.heap_pos;
+    in_state.heap_pos = nullptr;
+    delete [] in_state.distance;
+    in_state.distance = nullptr;
 }
 
 /*
@@ -275,27 +298,6 @@ void AP_ADSB::update(void)
     } // chan_last_ms
 }
 
-/*
- * determine index and distance of furthest vehicle. This is
- * used to bump it off when a new closer aircraft is detected
- */
-void AP_ADSB::determine_furthest_aircraft(void)
-{
-    float max_distance = 0;
-    uint16_t max_distance_index = 0;
-
-    for (uint16_t index = 0; index < in_state.vehicle_count; index++) {
-        float distance = _my_loc.get_distance(get_location(in_state.vehicle_list[index]));
-        if (max_distance < distance || index == 0) {
-            max_distance = distance;
-            max_distance_index = index;
-        }
-    } // for index
-
-    furthest_vehicle_index = max_distance_index;
-    furthest_vehicle_distance = max_distance;
-}
-
 /*
  * Convert/Extract a Location from a vehicle
  */
@@ -317,17 +319,31 @@ Location_Class AP_ADSB::get_location(const adsb_vehicle_t &vehicle) const
 void AP_ADSB::delete_vehicle(const uint16_t index)
 {
     if (index < in_state.vehicle_count) {
-        // if the vehicle is the furthest, invalidate it. It has been bumped
-        if (index == furthest_vehicle_index && furthest_vehicle_distance > 0) {
-            furthest_vehicle_distance = 0;
-            furthest_vehicle_index = 0;
+        const uint16_t last = in_state.vehicle_count-1;
+
+        icao_remove(index);
+
+        // take it out of the distance heap by swapping in the last heap entry
+        const uint16_t pos = in_state.heap_pos[index];
+        heap_swap(pos, last);
+        in_state.vehicle_count--;
+        if (pos < in_state.vehicle_count) {
+            const uint16_t moved = in_state.heap[pos];
+            heap_sift_up(pos);
+            heap_sift_down(in_state.heap_pos[moved]);
         }
-        if (index != (in_state.vehicle_count-1)) {
-            in_state.vehicle_list[index] = in_state.vehicle_list[in_state.vehicle_count-1];
+
+        if (index != last) {
+            in_state.vehicle_list[index] = in_state.vehicle_list[last];
+
+            // the last vehicle now lives at index, re-point its hash slot and heap entry
+            in_state.icao_table[icao_slot(in_state.vehicle_list[index].info.ICAO_address)] = index + 1;
+            in_state.heap_pos[index] = in_state.heap_pos[last];
+            in_state.heap[in_state.heap_pos[index]] = index;
+            in_state.distance[index] = in_state.distance[last];
         }
         // TODO: is memset needed? When we decrement the index we essentially forget about it
-        memset(&in_state.vehicle_list[in_state.vehicle_count-1], 0, sizeof(adsb_vehicle_t));
-        in_state.vehicle_count--;
+        memset(&in_state.vehicle_list[last], 0, sizeof(adsb_vehicle_t));
     }
 }
 
@@ -338,13 +354,107 @@ void AP_ADSB::delete_vehicle(const uint16_t index)
  */
 bool AP_ADSB::find_index(const adsb_vehicle_t &vehicle, uint16_t *index) const
 {
-    for (uint16_t i = 0; i < in_state.vehicle_count; i++) {
-        if (in_state.vehicle_list[i].info.ICAO_address == vehicle.info.ICAO_address) {
-            *index = i;
-            return true;
+    const uint16_t entry = in_state.icao_table[icao_slot(vehicle.info.ICAO_address)];
+    if (entry == 0) {
+        return false;
+    }
+    *index = entry - 1;
+    return true;
+}
+
+/*
+ * return the hash table slot holding ICAO_address, or the empty slot
+ * where it would be inserted. The table is never more than half full
+ * so the linear probe always terminates
+ */
+uint16_t AP_ADSB::icao_slot(const uint32_t ICAO_address) const
+{
+    uint16_t slot = ((ICAO_address * 2654435761U) >> 16) & in_state.icao_table_mask;
+    while (in_state.icao_table[slot] != 0 &&
+           in_state.vehicle_list[in_state.icao_table[slot]-1].info.ICAO_address != ICAO_address) {
+        slot = (slot + 1) & in_state.icao_table_mask;
+    }
+    return slot;
+}
+
+// add the vehicle at index to the ICAO hash table
+void AP_ADSB::icao_insert(const uint16_t index)
+{
+    in_state.icao_table[icao_slot(in_state.vehicle_list[index].info.ICAO_address)] = index + 1;
+}
+
+/*
+ * remove the vehicle at index from the ICAO hash table. Entries
+ * further along the probe sequence are shifted back into the hole so
+ * lookups never need tombstones
+ */
+void AP_ADSB::icao_remove(const uint16_t index)
+{
+    const uint16_t mask = in_state.icao_table_mask;
+    uint16_t hole = icao_slot(in_state.vehicle_list[index].info.ICAO_address);
+    if (in_state.icao_table[hole] == 0) {
+        return;
+    }
+    in_state.icao_table[hole] = 0;
+
+    uint16_t slot = (hole + 1) & mask;
+    while (in_state.icao_table[slot] != 0) {
+        const uint32_t ICAO_address = in_state.vehicle_list[in_state.icao_table[slot]-1].info.ICAO_address;
+        const uint16_t home = ((ICAO_address * 2654435761U) >> 16) & mask;
+        // move the entry back if the hole lies between its home slot and where it sits now
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            in_state.icao_table[hole] = in_state.icao_table[slot];
+            in_state.icao_table[slot] = 0;
+            hole = slot;
         }
+        slot = (slot + 1) & mask;
+    }
+}
+
+// exchange two entries of the distance heap
+void AP_ADSB::heap_swap(const uint16_t a, const uint16_t b)
+{
+    const uint16_t index_a = in_state.heap[a];
+    const uint16_t index_b = in_state.heap[b];
+    in_state.heap[a] = index_b;
+    in_state.heap[b] = index_a;
+    in_state.heap_pos[index_b] = a;
+    in_state.heap_pos[index_a] = b;
+}
+
+// move a heap entry towards the root while it is further than its parent
+void AP_ADSB::heap_sift_up(uint16_t pos)
+{
+    while (pos > 0) {
+        const uint16_t parent = (pos - 1) / 2;
+        if (in_state.distance[in_state.heap[pos]] <= in_state.distance[in_state.heap[parent]]) {
+            break;
+        }
+        heap_swap(pos, parent);
+        pos = parent;
+    }
+}
+
+// move a heap entry towards the leaves while a child is further than it
+void AP_ADSB::heap_sift_down(uint16_t pos)
+{
+    const uint16_t count = in_state.vehicle_count;
+    while (true) {
+        const uint16_t left = 2 * pos + 1;
+        if (left >= count) {
+            break;
+        }
+        uint16_t child = left;
+        if (left + 1 < count &&
+            in_state.distance[in_state.heap[left + 1]] > in_state.distance[in_state.heap[left]]) {
+            child = left + 1;
+        }
+        if (in_state.distance[in_state.heap[child]] <= in_state.distance[in_state.heap[pos]]) {
+            break;
+        }
+        heap_swap(pos, child);
+        pos = child;
     }
-    return false;
 }
 
 /*
@@ -390,37 +500,26 @@ void AP_ADSB::handle_vehicle(const mavlink_message_t* packet)
     } else if (is_tracked_in_list) {
 
         // found, update it
-        set_vehicle(index, vehicle);
+        set_vehicle(index, vehicle, my_loc_distance_to_vehicle);
 
     } else if (in_state.vehicle_count < in_state.list_size) {
 
         // not found and there's room, add it to the end of the list
-        set_vehicle(in_state.vehicle_count, vehicle);
-        in_state.vehicle_count++;
-
-    } else {
-        // buffer is full. if new vehicle is closer than furthest, replace furthest with new
-
-        if (my_loc_is_zero) {
-            // nothing else to do
-            furthest_vehicle_distance = 0;
-            furthest_vehicle_index = 0;
-
-        } else {
-            if (furthest_vehicle_distance <= 0) {
-                // ensure this is populated
-                determine_furthest_aircraft();
-            }
-
-            if (my_loc_distance_to_vehicle < furthest_vehicle_distance) { // is closer than the furthest
-                // replace with the furthest vehicle
-                set_vehicle(furthest_vehicle_index, vehicle);
-
-                // furthest_vehicle_index is now invalid because the vehicle was overwritten, need
-                // to run determine_furthest_aircraft() to determine a new one next time
-                furthest_vehicle_distance = 0;
-                furthest_vehicle_index = 0;
-            }
+        index = in_state.vehicle_count++;
+        in_state.heap[index] = index;
+        in_state.heap_pos[index] = index;
+        set_vehicle(index, vehicle, my_loc_distance_to_vehicle);
+        icao_insert(index);
+
+    } else if (!my_loc_is_zero) {
+        // buffer is full. if new vehicle is closer than furthest, replace furthest with new.
+        // Distances are as of each vehicle's last report, which is
+        // close enough for picking one to bump off
+        index = furthest_vehicle_index();
+        if (my_loc_distance_to_vehicle < in_state.distance[index]) { // is closer than the furthest
+            icao_remove(index);
+            set_vehicle(index, vehicle, my_loc_distance_to_vehicle);
+            icao_insert(index);
         }
     } // if buffer full
 
@@ -438,10 +537,15 @@ void AP_ADSB::handle_vehicle(const mavlink_message_t* packet)
 /*
  * Copy a vehicle's data into the list
  */
-void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle)
+void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance)
 {
-    if (index < in_state.list_size) {
+    if (index < in_state.vehicle_count) {
         in_state.vehicle_list[index] = vehicle;
+
+        // re-position it in the distance heap
+        in_state.distance[index] = distance;
+        heap_sift_up(in_state.heap_pos[index]);
+        heap_sift_down(in_state.heap_pos[index]);
     }
 }
 
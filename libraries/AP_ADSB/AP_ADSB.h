@@ -87,8 +87,8 @@ private:
     // free _vehicle_list
     void deinit();
 
-    // compares current vector against vehicle_list to detect threats
-    void determine_furthest_aircraft(void);
+    // return index of the vehicle furthest from us, taken from the top of the distance heap
+    uint16_t furthest_vehicle_index(void) const { return in_state.heap[0]; }
 
     // return index of given vehicle if ICAO_ADDRESS matches. return -1 if no match
     bool find_index(const adsb_vehicle_t &vehicle, uint16_t *index) const;
@@ -96,7 +96,17 @@ private:
     // remove a vehicle from the list
     void delete_vehicle(const uint16_t index);
 
-    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle);
+    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance);
+
+    // ICAO hash table maintenance
+    uint16_t icao_slot(const uint32_t ICAO_address) const;
+    void icao_insert(const uint16_t index);
+    void icao_remove(const uint16_t index);
+
+    // distance heap maintenance
+    void heap_swap(const uint16_t a, const uint16_t b);
+    void heap_sift_up(uint16_t pos);
+    void heap_sift_down(uint16_t pos);
 
     // Generates pseudorandom ICAO from gps time, lat, and lon
     uint32_t genICAO(const Location_Class &loc);
@@ -132,6 +142,19 @@ private:
         uint16_t    list_size = 1; // start with tiny list, then change to param-defined size. This ensures it doesn't fail on start
         adsb_vehicle_t *vehicle_list = nullptr;
         uint16_t    vehicle_count;
+
+        // open addressing hash of ICAO_address to vehicle_list index + 1,
+        // zero marks an empty slot. Sized to a power of two at least
+        // twice list_size so probe sequences stay short
+        uint16_t    *icao_table = nullptr;
+        uint16_t    icao_table_mask;
+
+        // max-heap of vehicle_list indexes ordered by distance from us
+        // when the vehicle was last reported. heap_pos is the inverse
+        // mapping from a vehicle_list index to its position in the heap
+        uint16_t    *heap = nullptr;
+        uint16_t    *heap_pos = nullptr;
+        float       *distance = nullptr;
         AP_Int32    list_radius;
 
         // streamrate stuff
@@ -172,10 +195,6 @@ private:
     } out_state;
 
 
-    // index of and distance to furthest vehicle in list
-    uint16_t    furthest_vehicle_index;
-    float       furthest_vehicle_distance;
-
     static const uint8_t max_samples = 30;
     AP_Buffer<adsb_vehicle_t, max_samples> samples;
 
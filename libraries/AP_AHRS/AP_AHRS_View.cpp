@@ -78,6 +78,13 @@ Vector3f AP_AHRS_View::get_gyro_latest(void) const {
     return gyro_latest;
 }
 
+// return an ins gyro sample corrected with a gyro drift estimate and rotated into this view
+Vector3f AP_AHRS_View::correct_gyro(const Vector3f &ins_gyro, const Vector3f &gyro_drift) const {
+    Vector3f gyro_corrected = ins_gyro + gyro_drift;
+    gyro_corrected.rotate(rotation);
+    return gyro_corrected;
+}
+
 // rotate a 2D vector from earth frame to body frame
 Vector2f AP_AHRS_View::rotate_earth_to_body2D(const Vector2f &ef) const
 {
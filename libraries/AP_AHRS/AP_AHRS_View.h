@@ -42,6 +42,15 @@ public:
     // return a smoothed and corrected gyro vector using the latest ins data (which may not have been consumed by the EKF yet)
     Vector3f get_gyro_latest(void) const;
 
+    // return the gyro drift estimate of the AHRS, in the body frame
+    const Vector3f &get_gyro_drift(void) const {
+        return ahrs.get_gyro_drift();
+    }
+
+    // return an ins gyro sample corrected with a gyro drift estimate from
+    // get_gyro_drift() and rotated into this view
+    Vector3f correct_gyro(const Vector3f &ins_gyro, const Vector3f &gyro_drift) const;
+
     // return a DCM rotation matrix representing our current
     // attitude in this view
     const Matrix3f &get_rotation_body_to_ned(void) const {
@@ -140,16 +140,38 @@ void AP_Avoidance::init(void)
     debug("ADSB initialisation: %d obstacles", _obstacles_max.get());
     if (_obstacles == nullptr) {
         _obstacles = new AP_Avoidance::Obstacle[_obstacles_max];
+        _obstacles_allocated = _obstacles_max;
 
-        if (_obstacles == nullptr) {
+        uint16_t table_size = 1;
+        while (table_size < 2 * _obstacles_allocated) {
+            table_size <<= 1;
+        }
+        _obstacle_table = new uint8_t[table_size];
+        _obstacle_table_mask = table_size - 1;
+        _age_heap = new uint8_t[_obstacles_allocated];
+        _age_heap_pos = new uint8_t[_obstacles_allocated];
+
+        if (_obstacles == nullptr ||
+            _obstacle_table == nullptr ||
+            _age_heap == nullptr ||
+            _age_heap_pos == nullptr) {
             // dynamic RAM allocation of _obstacles[] failed, disable gracefully
             hal.console->printf("Unable to initialize Avoidance obstacle list\n");
+            delete [] _obstacles;
+            _obstacles = nullptr;
+            delete [] _obstacle_table;
+            _obstacle_table = nullptr;
+            delete [] _age_heap;
+            _age_heap = nullptr;
+            delete [] _age_heap_pos;
+            _age_heap_pos = nullptr;
+            _obstacles_allocated = 0;
             // disable ourselves to avoid repeated allocation attempts
             _enabled.set(0);
             return;
         }
-        _obstacles_allocated = _obstacles_max;
     }
+    memset(_obstacle_table, 0, _obstacle_table_mask + 1);
     _obstacle_count = 0;
     _last_state_change_ms = 0;
     _threat_level = MAV_COLLISION_THREAT_LEVEL_NONE;
@@ -165,6 +187,12 @@ void AP_Avoidance::deinit(void)
     if (_obstacles != nullptr) {
         delete [] _obstacles;
         _obstacles = nullptr;
+        delete [] _obstacle_table;
+        _obstacle_table = nullptr;
+        delete [] _age_heap;
+        _age_heap = nullptr;
+        delete [] _age_heap_pos;
+        _age_heap_pos = nullptr;
         _obstacles_allocated = 0;
         handle_recovery(AP_AVOIDANCE_RECOVERY_RTL);
     }
@@ -196,30 +224,24 @@ void AP_Avoidance::add_obstacle(const uint32_t obstacle_timestamp_ms,
     if (! check_startup()) {
         return;
     }
-    uint32_t oldest_timestamp = std::numeric_limits<uint32_t>::max();
-    uint8_t oldest_index = 255; // avoid compiler warning with initialisation
+    const uint8_t slot = obstacle_slot(src, src_id);
     int16_t index = -1;
-    uint8_t i;
-    for (i=0; i<_obstacle_count; i++) {
-        if (_obstacles[i].src_id == src_id &&
-            _obstacles[i].src == src) {
-            // pre-existing obstacle found; we will update its information
-            index = i;
-            break;
-        }
-        if (_obstacles[i].timestamp_ms < oldest_timestamp) {
-            oldest_timestamp = _obstacles[i].timestamp_ms;
-            oldest_index = i;
-        }
-    }
-    if (index == -1) {
+    if (_obstacle_table[slot] != 0) {
+        // pre-existing obstacle found; we will update its information
+        index = _obstacle_table[slot] - 1;
+    } else {
         // existing obstacle not found.  See if we can store it anyway:
-        if (i <_obstacles_allocated) {
+        if (_obstacle_count < _obstacles_allocated) {
             // have room to store more vehicles...
             index = _obstacle_count++;
-        } else if (oldest_timestamp < obstacle_timestamp_ms) {
+            _age_heap[index] = index;
+            _age_heap_pos[index] = index;
+            _obstacle_table[slot] = index + 1;
+        } else if (_obstacles[_age_heap[0]].timestamp_ms < obstacle_timestamp_ms) {
             // replace this very old entry with this new data
-            index = oldest_index;
+            index = _age_heap[0];
+            obstacle_hash_remove(index);
+            _obstacle_table[obstacle_slot(src, src_id)] = index + 1;
         } else {
             // no room for this (old?!) data
             return;
@@ -232,6 +254,106 @@ void AP_Avoidance::add_obstacle(const uint32_t obstacle_timestamp_ms,
     _obstacles[index]._location = loc;
     _obstacles[index]._velocity = vel_ned;
     _obstacles[index].timestamp_ms = obstacle_timestamp_ms;
+    age_heap_update(index);
+}
+
+/*
+ * return the hash table slot holding the obstacle, or the empty slot
+ * where it would be inserted. The table is never more than half full
+ * so the linear probe always terminates
+ */
+uint8_t AP_Avoidance::obstacle_slot(const MAV_COLLISION_SRC src, const uint32_t src_id) const
+{
+    uint8_t slot = (((src_id ^ ((uint32_t)src << 24)) * 2654435761U) >> 16) & _obstacle_table_mask;
+    while (_obstacle_table[slot] != 0) {
+        const AP_Avoidance::Obstacle &obstacle = _obstacles[_obstacle_table[slot]-1];
+        if (obstacle.src_id == src_id && obstacle.src == src) {
+            break;
+        }
+        slot = (slot + 1) & _obstacle_table_mask;
+    }
+    return slot;
+}
+
+/*
+ * remove the obstacle at index from the hash table, shifting later
+ * entries of the probe sequence back into the hole
+ */
+void AP_Avoidance::obstacle_hash_remove(const uint8_t index)
+{
+    uint8_t hole = obstacle_slot(_obstacles[index].src, _obstacles[index].src_id);
+    if (_obstacle_table[hole] == 0) {
+        return;
+    }
+    _obstacle_table[hole] = 0;
+
+    uint8_t slot = (hole + 1) & _obstacle_table_mask;
+    while (_obstacle_table[slot] != 0) {
+        const AP_Avoidance::Obstacle &obstacle = _obstacles[_obstacle_table[slot]-1];
+        const uint8_t home = (((obstacle.src_id ^ ((uint32_t)obstacle.src << 24)) * 2654435761U) >> 16) & _obstacle_table_mask;
+        // move the entry back if the hole lies between its home slot and where it sits now
+        if (((slot - home) & _obstacle_table_mask) >= ((slot - hole) & _obstacle_table_mask)) {
+            _obstacle_table[hole] = _obstacle_table[slot];
+            _obstacle_table[slot] = 0;
+            hole = slot;
+        }
+        slot = (slot + 1) & _obstacle_table_mask;
+    }
+}
+
+// drop the last entry of _obstacles
+void AP_Avoidance::remove_last_obstacle()
+{
+    const uint8_t last = _obstacle_count - 1;
+    obstacle_hash_remove(last);
+
+    const uint8_t pos = _age_heap_pos[last];
+    age_heap_swap(pos, _obstacle_count - 1);
+    _obstacle_count--;
+    if (pos < _obstacle_count) {
+        age_heap_update(_age_heap[pos]);
+    }
+}
+
+// exchange two entries of the age heap
+void AP_Avoidance::age_heap_swap(const uint8_t a, const uint8_t b)
+{
+    const uint8_t index_a = _age_heap[a];
+    const uint8_t index_b = _age_heap[b];
+    _age_heap[a] = index_b;
+    _age_heap[b] = index_a;
+    _age_heap_pos[index_b] = a;
+    _age_heap_pos[index_a] = b;
+}
+
+// restore the age heap order after the timestamp of an obstacle changed
+void AP_Avoidance::age_heap_update(const uint8_t index)
+{
+    uint8_t pos = _age_heap_pos[index];
+    while (pos > 0) {
+        const uint8_t parent = (pos - 1) / 2;
+        if (_obstacles[_age_heap[parent]].timestamp_ms <= _obstacles[index].timestamp_ms) {
+            break;
+        }
+        age_heap_swap(pos, parent);
+        pos = parent;
+    }
+    while (true) {
+        const uint16_t left = 2 * pos + 1;
+        if (left >= _obstacle_count) {
+            break;
+        }
+        uint8_t child = left;
+        if (left + 1 < _obstacle_count &&
+            _obstacles[_age_heap[left + 1]].timestamp_ms < _obstacles[_age_heap[left]].timestamp_ms) {
+            child = left + 1;
+        }
+        if (_obstacles[index].timestamp_ms <= _obstacles[_age_heap[child]].timestamp_ms) {
+            break;
+        }
+        age_heap_swap(pos, child);
+        pos = child;
+    }
 }
 
 void AP_Avoidance::add_obstacle(const uint32_t obstacle_timestamp_ms,
@@ -465,7 +587,7 @@ void AP_Avoidance::check_for_threats()
         if (obstacle_age > MAX_OBSTACLE_AGE_MS) {
             // shrink list if this is the last entry:
             if (i == _obstacle_count-1) {
-                _obstacle_count -= 1;
+                remove_last_obstacle();
             }
             continue;
         }
@@ -170,10 +170,28 @@ private:
     // threat than the current most serious threat
     bool obstacle_is_more_serious_threat(const AP_Avoidance::Obstacle &obstacle) const;
 
+    // obstacle hash table and age heap maintenance
+    uint8_t obstacle_slot(const MAV_COLLISION_SRC src, const uint32_t src_id) const;
+    void obstacle_hash_remove(const uint8_t index);
+    void remove_last_obstacle();
+    void age_heap_swap(const uint8_t a, const uint8_t b);
+    void age_heap_update(const uint8_t index);
+
     // internal variables
     AP_Avoidance::Obstacle *_obstacles;
     uint8_t _obstacles_allocated;
     uint8_t _obstacle_count;
+
+    // open addressing hash of (src, src_id) to _obstacles index + 1,
+    // zero marks an empty slot. At most half full
+    uint8_t *_obstacle_table;
+    uint8_t _obstacle_table_mask;
+
+    // min-heap of _obstacles indexes ordered by timestamp_ms, so the
+    // oldest obstacle can be replaced without a scan
+    uint8_t *_age_heap;
+    uint8_t *_age_heap_pos;
+
     int8_t _current_most_serious_threat;
     MAV_COLLISION_ACTION _latest_action = MAV_COLLISION_ACTION_NONE;
 
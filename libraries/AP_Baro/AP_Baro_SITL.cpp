@@ -60,43 +60,15 @@ void AP_Baro_SITL::_timer()
     }
 
     sim_alt += _sitl->baro_drift * now / 1000.0f;
-    sim_alt += _sitl->baro_noise * rand_float();
+    sim_alt += _sitl->baro_noise * _noise.next();
 
     // add baro glitch
     sim_alt += _sitl->baro_glitch;
 
-    // add delay
-    uint32_t best_time_delta = 200;  // initialise large time representing buffer entry closest to current time - delay.
-    uint8_t best_index = 0;  // initialise number representing the index of the entry in buffer closest to delay.
-
-    // storing data from sensor to buffer
-    if (now - _last_store_time >= 10) {  // store data every 10 ms.
-        _last_store_time = now;
-        if (_store_index > _buffer_length - 1) {  // reset buffer index if index greater than size of buffer
-            _store_index = 0;
-        }
-        _buffer[_store_index].data = sim_alt;  // add data to current index
-        _buffer[_store_index].time = _last_store_time;  // add time_stamp to current index
-        _store_index = _store_index + 1;  // increment index
-    }
-
-    // return delayed measurement
-    const uint32_t delayed_time = now - _sitl->baro_delay;  // get time corresponding to delay
-
-    // find data corresponding to delayed time in buffer
-    for (uint8_t i = 0; i <= _buffer_length - 1; i++) {
-        // find difference between delayed time and time stamp in buffer
-        uint32_t time_delta = abs(
-                (int32_t)(delayed_time - _buffer[i].time));
-        // if this difference is smaller than last delta, store this time
-        if (time_delta < best_time_delta) {
-            best_index = i;
-            best_time_delta = time_delta;
-        }
-    }
-    if (best_time_delta < 200) {  // only output stored state if < 200 msec retrieval error
-        sim_alt = _buffer[best_index].data;
-    }
+    // add delay, storing data every 10 ms and only using the stored
+    // state if it is within 200 msec of the delayed time
+    _delay.push(now, sim_alt);
+    _delay.get(now, _sitl->baro_delay, 200, sim_alt);
 
 #if !APM_BUILD_TYPE(APM_BUILD_ArduSub)
     float sigma, delta, theta;
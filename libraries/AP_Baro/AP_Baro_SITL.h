@@ -4,7 +4,7 @@
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 #include <SITL/SITL.h>
-#include <AP_Math/vectorN.h>
+#include <SITL/SIM_SensorPipeline.h>
 
 class AP_Baro_SITL : public AP_Baro_Backend {
 public:
@@ -20,15 +20,9 @@ private:
     uint8_t _instance;
     SITL::SITL *_sitl;
 
-    // barometer delay buffer variables
-    struct readings_baro {
-        uint32_t time;
-        float data;
-    };
-    uint8_t _store_index;
-    uint32_t _last_store_time;
-    static const uint8_t _buffer_length = 50;
-    VectorN<readings_baro, _buffer_length> _buffer;
+    // barometer noise and delay
+    SITL::NoiseSource _noise;
+    SITL::SensorDelay<float, 50> _delay{10};
 
     // adjust for simulated board temperature
     void temperature_adjustment(float &p, float &T);
@@ -370,6 +370,12 @@ private:
     bool _cal_complete_requires_reboot;
     bool _cal_has_run;
 
+    // calibration fits run on their own thread where the HAL
+    // supports it, keeping them off the main loop
+    void _calibration_thread(void);
+    bool _cal_thread_started;
+    bool _cal_thread_ok;
+
     // enum of drivers for COMPASS_TYPEMASK
     enum DriverType {
         DRIVER_HMC5883  =0,
@@ -6,6 +6,15 @@
 
 extern AP_HAL::HAL& hal;
 
+#ifndef COMPASS_CAL_THREAD_STACK
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+# define COMPASS_CAL_THREAD_STACK 4096
+#else
+// no less than PTHREAD_STACK_MIN on Linux and SITL
+# define COMPASS_CAL_THREAD_STACK 16384
+#endif
+#endif
+
 void
 Compass::compass_cal_update()
 {
@@ -41,6 +50,26 @@ Compass::compass_cal_update()
     }
 }
 
+/*
+  run the fit iterations requested by compass_cal_update(). An
+  iteration over the full sample buffer takes a few milliseconds, so
+  running them here keeps three compasses calibrating without
+  overrunning the main loop
+ */
+void
+Compass::_calibration_thread(void)
+{
+    while (true) {
+        bool ran = false;
+        for (uint8_t i=0; i<COMPASS_MAX_INSTANCES; i++) {
+            if (_calibrator[i].run_pending_fit()) {
+                ran = true;
+            }
+        }
+        hal.scheduler->delay(ran ? 1 : 10);
+    }
+}
+
 bool
 Compass::_start_calibration(uint8_t i, bool retry, float delay)
 {
@@ -67,6 +96,25 @@ Compass::_start_calibration(uint8_t i, bool retry, float delay)
             _calibrator[i].set_orientation(r, _state[i].external, _rotate_auto>=2);
         }
     }
+    if (!_cal_thread_started) {
+        _cal_thread_started = true;
+        // the thread reads the semaphores, so create them first
+        _cal_thread_ok = true;
+        for (uint8_t j=0; j<COMPASS_MAX_INSTANCES; j++) {
+            if (!_calibrator[j].create_fit_semaphore()) {
+                _cal_thread_ok = false;
+            }
+        }
+        if (_cal_thread_ok) {
+            _cal_thread_ok = hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Compass::_calibration_thread, void),
+                                                          "compasscal", COMPASS_CAL_THREAD_STACK,
+                                                          AP_HAL::Scheduler::PRIORITY_IO, 0);
+        }
+        if (!_cal_thread_ok) {
+            gcs().send_text(MAV_SEVERITY_WARNING, "CompassCal: no fit thread, fitting in main loop");
+        }
+    }
+    _calibrator[i].set_fit_thread(_cal_thread_ok);
     _cal_saved[i] = false;
     _calibrator[i].start(retry, delay, get_offsets_max(), i);
 
@@ -200,7 +248,8 @@ Compass::send_mag_cal_progress(mavlink_channel_t chan)
             cal_status == COMPASS_CAL_RUNNING_STEP_ONE ||
             cal_status == COMPASS_CAL_RUNNING_STEP_TWO) {
             uint8_t completion_pct = calibrator.get_completion_percent();
-            auto& completion_mask = calibrator.get_completion_mask();
+            CompassCalibrator::completion_mask_t completion_mask;
+            calibrator.get_completion_mask(completion_mask);
             Vector3f direction(0.0f,0.0f,0.0f);
             uint8_t attempt = _calibrator[compass_id].get_attempt();
 
@@ -59,8 +59,6 @@ void AP_Compass_SITL::_setup_eliptical_correcion(void)
 
 void AP_Compass_SITL::_timer()
 {
-    // TODO: Refactor delay buffer with AP_Baro_SITL.
-
     // Sampled at 100Hz
     uint32_t now = AP_HAL::millis();
     if ((now - _last_sample_time) < 10) {
@@ -70,39 +68,17 @@ void AP_Compass_SITL::_timer()
 
     // calculate sensor noise and add to 'truth' field in body frame
     // units are milli-Gauss
-    Vector3f noise = rand_vec3f() * _sitl->mag_noise;
-    Vector3f new_mag_data = _sitl->state.bodyMagField + noise;
-
-    // add delay
-    uint32_t best_time_delta = 1000; // initialise large time representing buffer entry closest to current time - delay.
-    uint8_t best_index = 0; // initialise number representing the index of the entry in buffer closest to delay.
-
-    // storing data from sensor to buffer
-    if (now - last_store_time >= 10) { // store data every 10 ms.
-        last_store_time = now;
-        if (store_index > buffer_length-1) { // reset buffer index if index greater than size of buffer
-            store_index = 0;
-        }
-        buffer[store_index].data = new_mag_data; // add data to current index
-        buffer[store_index].time = last_store_time; // add time to current index
-        store_index = store_index + 1; // increment index
+    Vector3f noise = _noise.next_vec3f();
+    if (!noise.is_zero()) {
+        noise.normalize();
     }
+    noise *= _sitl->mag_noise;
+    Vector3f new_mag_data = _sitl->state.bodyMagField + noise;
 
-    // return delayed measurement
-    uint32_t delayed_time = now - _sitl->mag_delay; // get time corresponding to delay
-    // find data corresponding to delayed time in buffer
-    for (uint8_t i=0; i<=buffer_length-1; i++) {
-        // find difference between delayed time and time stamp in buffer
-        uint32_t time_delta = abs((int32_t)(delayed_time - buffer[i].time));
-        // if this difference is smaller than last delta, store this time
-        if (time_delta < best_time_delta) {
-            best_index= i;
-            best_time_delta = time_delta;
-        }
-    }
-    if (best_time_delta < 1000) { // only output stored state if < 1 sec retrieval error
-        new_mag_data = buffer[best_index].data;
-    }
+    // add delay, storing data every 10 ms and only using the stored
+    // state if it is within 1 sec of the delayed time
+    _delay.push(now, new_mag_data);
+    _delay.get(now, _sitl->mag_delay, 1000, new_mag_data);
 
     _setup_eliptical_correcion();        
     
@@ -5,7 +5,7 @@
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 #include <SITL/SITL.h>
-#include <AP_Math/vectorN.h>
+#include <SITL/SIM_SensorPipeline.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Declination/AP_Declination.h>
 
@@ -21,15 +21,9 @@ private:
     uint8_t _compass_instance[SITL_NUM_COMPASSES];
     SITL::SITL *_sitl;
 
-    // delay buffer variables
-    struct readings_compass {
-        uint32_t time;
-        Vector3f data;
-    };
-    uint8_t store_index;
-    uint32_t last_store_time;
-    static const uint8_t buffer_length = 50;
-    VectorN<readings_compass,buffer_length> buffer;
+    // field noise and delay
+    SITL::NoiseSource _noise;
+    SITL::SensorDelay<Vector3f, 50> _delay{10};
 
     void _timer();
     bool _has_sample;
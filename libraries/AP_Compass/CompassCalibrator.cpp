@@ -71,7 +71,12 @@ extern const AP_HAL::HAL& hal;
 
 CompassCalibrator::CompassCalibrator():
 _tolerance(COMPASS_CAL_DEFAULT_TOLERANCE),
-_sample_buffer(nullptr)
+_sample_buffer(nullptr),
+_fit_sem(nullptr),
+_fit_pending(FIT_NONE),
+_fit_running(false),
+_fit_cancelled(false),
+_use_fit_thread(false)
 {
     clear();
 }
@@ -94,14 +99,24 @@ void CompassCalibrator::start(bool retry, float delay, uint16_t offset_max, uint
     set_status(COMPASS_CAL_WAITING_TO_START);
 }
 
-void CompassCalibrator::get_calibration(Vector3f &offsets, Vector3f &diagonals, Vector3f &offdiagonals) {
+void CompassCalibrator::get_calibration(Vector3f &offsets, Vector3f &diagonals, Vector3f &offdiagonals) const {
     if (_status != COMPASS_CAL_SUCCESS) {
         return;
     }
 
+    fit_lock();
     offsets = _params.offset;
     diagonals = _params.diag;
     offdiagonals = _params.offdiag;
+    fit_unlock();
+}
+
+float CompassCalibrator::get_fitness() const
+{
+    fit_lock();
+    const float fitness = _fitness;
+    fit_unlock();
+    return sqrtf(fitness);
 }
 
 float CompassCalibrator::get_completion_percent() const {
@@ -136,20 +151,54 @@ void CompassCalibrator::update_completion_mask(const Vector3f& v)
     if (section < 0) {
         return;
     }
+    fit_lock();
     _completion_mask[section / 8] |= 1 << (section % 8);
+    fit_unlock();
 }
 
 void CompassCalibrator::update_completion_mask()
 {
-    memset(_completion_mask, 0, sizeof(_completion_mask));
-    for (int i = 0; i < _samples_collected; i++) {
-        update_completion_mask(_sample_buffer[i].get());
+    completion_mask_t mask;
+    calc_completion_mask(_sample_buffer, _samples_collected, _params, mask);
+    fit_lock();
+    memcpy(_completion_mask, mask, sizeof(_completion_mask));
+    fit_unlock();
+}
+
+void CompassCalibrator::calc_completion_mask(const CompassSample *samples, uint16_t num_samples,
+                                             const param_t &params, completion_mask_t &mask) const
+{
+    memset(mask, 0, sizeof(mask));
+
+    Matrix3f softiron{
+        params.diag.x,    params.offdiag.x, params.offdiag.y,
+        params.offdiag.x, params.diag.y,    params.offdiag.z,
+        params.offdiag.y, params.offdiag.z, params.diag.z
+    };
+
+    // classify the samples a batch at a time, small enough to be cheap
+    // on the stack of the fit thread
+    Vector3f corrected[COMPASS_CAL_SECTION_BATCH];
+    int sections[COMPASS_CAL_SECTION_BATCH];
+    for (uint16_t i = 0; i < num_samples; i += COMPASS_CAL_SECTION_BATCH) {
+        const uint16_t n = MIN(num_samples - i, COMPASS_CAL_SECTION_BATCH);
+        for (uint16_t k = 0; k < n; k++) {
+            corrected[k] = softiron * (samples[i+k].get() + params.offset);
+        }
+        AP_GeodesicGrid::sections(corrected, sections, n, true);
+        for (uint16_t k = 0; k < n; k++) {
+            if (sections[k] >= 0) {
+                mask[sections[k] / 8] |= 1 << (sections[k] % 8);
+            }
+        }
     }
 }
 
-CompassCalibrator::completion_mask_t& CompassCalibrator::get_completion_mask()
+void CompassCalibrator::get_completion_mask(completion_mask_t &mask) const
 {
-    return _completion_mask;
+    fit_lock();
+    memcpy(mask, _completion_mask, sizeof(mask));
+    fit_unlock();
 }
 
 bool CompassCalibrator::check_for_timeout() {
@@ -173,6 +222,7 @@ void CompassCalibrator::new_sample(const Vector3f& sample) {
         update_completion_mask(sample);
         _sample_buffer[_samples_collected].set(sample);
         _sample_buffer[_samples_collected].att.set_from_ahrs();
+        sphere_sums_update(_sample_buffer[_samples_collected].get(), 1.0f);
         _samples_collected++;
     }
 }
@@ -183,6 +233,12 @@ void CompassCalibrator::update(bool &failure) {
     if(!fitting()) {
         return;
     }
+    fit_lock();
+    const bool fit_pending = _fit_pending != FIT_NONE;
+    fit_unlock();
+    if (fit_pending) {
+        return;
+    }
 
     if(_status == COMPASS_CAL_RUNNING_STEP_ONE) {
         if (_fit_step >= 10) {
@@ -195,7 +251,7 @@ void CompassCalibrator::update(bool &failure) {
             if (_fit_step == 0) {
                 calc_initial_offset();
             }
-            run_sphere_fit();
+            request_fit(FIT_SPHERE);
             _fit_step++;
         }
     } else if(_status == COMPASS_CAL_RUNNING_STEP_TWO) {
@@ -207,15 +263,57 @@ void CompassCalibrator::update(bool &failure) {
                 failure = true;
             }
         } else if (_fit_step < 15) {
-            run_sphere_fit();
+            request_fit(FIT_SPHERE);
             _fit_step++;
         } else {
-            run_ellipsoid_fit();
+            request_fit(FIT_ELLIPSOID);
             _fit_step++;
         }
     }
 }
 
+bool CompassCalibrator::create_fit_semaphore()
+{
+    if (_fit_sem == nullptr) {
+        _fit_sem = hal.util->new_semaphore();
+    }
+    return _fit_sem != nullptr;
+}
+
+bool CompassCalibrator::run_pending_fit()
+{
+    // take a copy of the fit state, the main thread leaves it alone
+    // until the fit is complete or cancelled
+    fit_lock();
+    const fit_type_t type = _fit_pending;
+    fit_state s;
+    if (type != FIT_NONE) {
+        get_fit_state(type, s);
+        _fit_running = true;
+    }
+    fit_unlock();
+    if (type == FIT_NONE) {
+        return false;
+    }
+
+    const bool improved = run_fit(type, s);
+
+    fit_lock();
+    _fit_running = false;
+    if (_fit_cancelled) {
+        // the calibration was stopped during the fit and the sample
+        // buffer was handed to this thread
+        _fit_cancelled = false;
+        fit_unlock();
+        free(const_cast<CompassSample *>(s.samples));
+        return true;
+    }
+    set_fit_state(type, s, improved);
+    _fit_pending = FIT_NONE;
+    fit_unlock();
+    return true;
+}
+
 /////////////////////////////////////////////////////////////
 ////////////////////// PRIVATE METHODS //////////////////////
 /////////////////////////////////////////////////////////////
@@ -227,6 +325,90 @@ bool CompassCalibrator::fitting() const {
     return running() && _samples_collected == COMPASS_CAL_NUM_SAMPLES;
 }
 
+void CompassCalibrator::fit_lock() const
+{
+    if (_fit_sem != nullptr) {
+        _fit_sem->take_blocking();
+    }
+}
+
+void CompassCalibrator::fit_unlock() const
+{
+    if (_fit_sem != nullptr) {
+        _fit_sem->give();
+    }
+}
+
+void CompassCalibrator::request_fit(fit_type_t type)
+{
+    fit_lock();
+    _fit_pending = type;
+    fit_unlock();
+    if (!_use_fit_thread) {
+        run_pending_fit();
+    }
+}
+
+// copy of the fit state for an iteration of type
+void CompassCalibrator::get_fit_state(fit_type_t type, fit_state &s) const
+{
+    s.samples = _sample_buffer;
+    s.num_samples = _samples_collected;
+    s.params = _params;
+    s.fitness = _fitness;
+    s.lambda = type == FIT_SPHERE ? _sphere_lambda : _ellipsoid_lambda;
+}
+
+// copy back the result of an iteration of type
+void CompassCalibrator::set_fit_state(fit_type_t type, const fit_state &s, bool improved)
+{
+    if (type == FIT_SPHERE) {
+        _sphere_lambda = s.lambda;
+    } else {
+        _ellipsoid_lambda = s.lambda;
+    }
+    if (improved) {
+        _params = s.params;
+        _fitness = s.fitness;
+        memcpy(_completion_mask, s.completion_mask, sizeof(_completion_mask));
+    }
+}
+
+bool CompassCalibrator::run_fit(fit_type_t type, fit_state &s) const
+{
+    if (type == FIT_SPHERE) {
+        return run_sphere_fit(s);
+    }
+    return run_ellipsoid_fit(s);
+}
+
+// run an iteration on the calling thread, when no fit is pending
+void CompassCalibrator::run_fit_now(fit_type_t type)
+{
+    fit_state s;
+    get_fit_state(type, s);
+    const bool improved = run_fit(type, s);
+    fit_lock();
+    set_fit_state(type, s, improved);
+    fit_unlock();
+}
+
+/*
+  drop any pending fit. If the fit thread is part way through one it
+  keeps the sample buffer and frees it when done, so the main thread
+  never waits for it
+ */
+void CompassCalibrator::cancel_fit()
+{
+    fit_lock();
+    _fit_pending = FIT_NONE;
+    if (_fit_running) {
+        _fit_cancelled = true;
+        _sample_buffer = nullptr;
+    }
+    fit_unlock();
+}
+
 void CompassCalibrator::initialize_fit() {
     //initialize _fitness before starting a fit
     if (_samples_collected != 0) {
@@ -247,6 +429,7 @@ void CompassCalibrator::reset_state() {
     _params.offset.zero();
     _params.diag = Vector3f(1.0f,1.0f,1.0f);
     _params.offdiag.zero();
+    memset(&_sphere_sums, 0, sizeof(_sphere_sums));
 
     memset(_completion_mask, 0, sizeof(_completion_mask));
     initialize_fit();
@@ -257,6 +440,8 @@ bool CompassCalibrator::set_status(compass_cal_status_t status) {
         return true;
     }
 
+    cancel_fit();
+
     switch(status) {
         case COMPASS_CAL_NOT_STARTED:
             reset_state();
@@ -384,6 +569,7 @@ void CompassCalibrator::thin_samples() {
 
     for(uint16_t i=0; i < _samples_collected; i++) {
         if(!accept_sample(_sample_buffer[i])) {
+            sphere_sums_update(_sample_buffer[i].get(), -1.0f);
             _sample_buffer[i] = _sample_buffer[_samples_collected-1];
             _samples_collected --;
             _samples_thinned ++;
@@ -450,16 +636,21 @@ float CompassCalibrator::calc_mean_squared_residuals() const
 
 float CompassCalibrator::calc_mean_squared_residuals(const param_t& params) const
 {
-    if(_sample_buffer == nullptr || _samples_collected == 0) {
+    return calc_mean_squared_residuals(params, _sample_buffer, _samples_collected);
+}
+
+float CompassCalibrator::calc_mean_squared_residuals(const param_t& params, const CompassSample *samples, uint16_t num_samples) const
+{
+    if(samples == nullptr || num_samples == 0) {
         return 1.0e30f;
     }
     float sum = 0.0f;
-    for(uint16_t i=0; i < _samples_collected; i++){
-        Vector3f sample = _sample_buffer[i].get();
+    for(uint16_t i=0; i < num_samples; i++){
+        Vector3f sample = samples[i].get();
         float resid = calc_residual(sample, params);
         sum += sq(resid);
     }
-    sum /= _samples_collected;
+    sum /= num_samples;
     return sum;
 }
 
@@ -486,8 +677,58 @@ void CompassCalibrator::calc_sphere_jacob(const Vector3f& sample, const param_t&
     ret[3] = -1.0f * (((offdiag.y * A) + (offdiag.z * B) + (diag.z    * C))/length);
 }
 
+void CompassCalibrator::sphere_sums_update(const Vector3f &sample, float sign)
+{
+    if (_samples_collected == 0 && sign > 0) {
+        memset(&_sphere_sums, 0, sizeof(_sphere_sums));
+        _sphere_sums.origin = sample;
+    }
+    const Vector3f p = sample - _sphere_sums.origin;
+    const float a[4] = { 2*p.x, 2*p.y, 2*p.z, 1.0f };
+    const float b = p.length_squared();
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            _sphere_sums.ATA[i*4+j] += sign * a[i] * a[j];
+        }
+        _sphere_sums.ATb[i] += sign * a[i] * b;
+    }
+}
+
+bool CompassCalibrator::sphere_sums_solve(Vector3f &offset, float &radius) const
+{
+    float ATA[4*4];
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            ATA[i*4+j] = ATA[j*4+i] = _sphere_sums.ATA[i*4+j];
+        }
+    }
+    float inv[4*4];
+    if (!inverse4x4(ATA, inv)) {
+        return false;
+    }
+    float x[4] = { };
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 4; j++) {
+            x[i] += inv[i*4+j] * _sphere_sums.ATb[j];
+        }
+    }
+    const Vector3f centre(x[0], x[1], x[2]);
+    const float r_sq = x[3] + centre.length_squared();
+    if (isnan(r_sq) || r_sq <= 0) {
+        return false;
+    }
+    offset = -(centre + _sphere_sums.origin);
+    radius = sqrtf(r_sq);
+    return true;
+}
+
 void CompassCalibrator::calc_initial_offset()
 {
+    // start from the least squares sphere through the samples
+    if (sphere_sums_solve(_params.offset, _params.radius)) {
+        return;
+    }
+
     // Set initial offset to the average value of the samples
     _params.offset.zero();
     for(uint16_t k = 0; k<_samples_collected; k++) {
@@ -496,56 +737,62 @@ void CompassCalibrator::calc_initial_offset()
     _params.offset /= _samples_collected;
 }
 
-void CompassCalibrator::run_sphere_fit()
+bool CompassCalibrator::run_sphere_fit(fit_state &s) const
 {
-    if(_sample_buffer == nullptr) {
-        return;
+    if(s.samples == nullptr) {
+        return false;
     }
 
     const float lma_damping = 10.0f;
 
-    float fitness = _fitness;
+    float fitness = s.fitness;
     float fit1, fit2;
     param_t fit1_params, fit2_params;
-    fit1_params = fit2_params = _params;
+    fit1_params = fit2_params = s.params;
 
     float JTJ[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
     float JTJ2[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
     float JTFI[COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
 
     // Gauss Newton Part common for all kind of extensions including LM
-    for(uint16_t k = 0; k<_samples_collected; k++) {
-        Vector3f sample = _sample_buffer[k].get();
+    for(uint16_t k = 0; k<s.num_samples; k++) {
+        Vector3f sample = s.samples[k].get();
 
         float sphere_jacob[COMPASS_CAL_NUM_SPHERE_PARAMS];
 
         calc_sphere_jacob(sample, fit1_params, sphere_jacob);
+        const float residual = calc_residual(sample, fit1_params);
 
         for(uint8_t i = 0;i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
-            // compute JTJ
-            for(uint8_t j = 0; j < COMPASS_CAL_NUM_SPHERE_PARAMS; j++) {
+            // compute JTJ, upper triangle only as it is symmetric
+            for(uint8_t j = i; j < COMPASS_CAL_NUM_SPHERE_PARAMS; j++) {
                 JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] += sphere_jacob[i] * sphere_jacob[j];
-                JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] += sphere_jacob[i] * sphere_jacob[j];   //a backup JTJ for LM
             }
             // compute JTFI
-            JTFI[i] += sphere_jacob[i] * calc_residual(sample, fit1_params);
+            JTFI[i] += sphere_jacob[i] * residual;
         }
     }
+    for(uint8_t i = 0; i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
+        for(uint8_t j = 0; j < i; j++) {
+            JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] = JTJ[j*COMPASS_CAL_NUM_SPHERE_PARAMS+i];
+        }
+    }
+    memcpy(JTJ2, JTJ, sizeof(JTJ2));   //a backup JTJ for LM
 
 
     //------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
     //refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
     for(uint8_t i = 0; i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
-        JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += _sphere_lambda;
-        JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += _sphere_lambda/lma_damping;
+        JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += s.lambda;
+        JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += s.lambda/lma_damping;
     }
 
     if(!inverse(JTJ, JTJ, 4)) {
-        return;
+        return false;
     }
 
     if(!inverse(JTJ2, JTJ2, 4)) {
-        return;
+        return false;
     }
 
     for(uint8_t row=0; row < COMPASS_CAL_NUM_SPHERE_PARAMS; row++) {
@@ -555,25 +802,27 @@ void CompassCalibrator::run_sphere_fit()
         }
     }
 
-    fit1 = calc_mean_squared_residuals(fit1_params);
-    fit2 = calc_mean_squared_residuals(fit2_params);
+    fit1 = calc_mean_squared_residuals(fit1_params, s.samples, s.num_samples);
+    fit2 = calc_mean_squared_residuals(fit2_params, s.samples, s.num_samples);
 
-    if(fit1 > _fitness && fit2 > _fitness){
-        _sphere_lambda *= lma_damping;
-    } else if(fit2 < _fitness && fit2 < fit1) {
-        _sphere_lambda /= lma_damping;
+    if(fit1 > s.fitness && fit2 > s.fitness){
+        s.lambda *= lma_damping;
+    } else if(fit2 < s.fitness && fit2 < fit1) {
+        s.lambda /= lma_damping;
         fit1_params = fit2_params;
         fitness = fit2;
-    } else if(fit1 < _fitness){
+    } else if(fit1 < s.fitness){
         fitness = fit1;
     }
     //--------------------Levenberg-Marquardt-part-ends-here--------------------------------//
 
-    if(!isnan(fitness) && fitness < _fitness) {
-        _fitness = fitness;
-        _params = fit1_params;
-        update_completion_mask();
+    if(!isnan(fitness) && fitness < s.fitness) {
+        s.fitness = fitness;
+        s.params = fit1_params;
+        calc_completion_mask(s.samples, s.num_samples, s.params, s.completion_mask);
+        return true;
     }
+    return false;
 }
 
 
@@ -607,19 +856,19 @@ void CompassCalibrator::calc_ellipsoid_jacob(const Vector3f& sample, const param
     ret[8] = -1.0f * (((sample.z + offset.z) * B) + ((sample.y + offset.y) * C))/length;
 }
 
-void CompassCalibrator::run_ellipsoid_fit()
+bool CompassCalibrator::run_ellipsoid_fit(fit_state &s) const
 {
-    if(_sample_buffer == nullptr) {
-        return;
+    if(s.samples == nullptr) {
+        return false;
     }
 
     const float lma_damping = 10.0f;
 
 
-    float fitness = _fitness;
+    float fitness = s.fitness;
     float fit1, fit2;
     param_t fit1_params, fit2_params;
-    fit1_params = fit2_params = _params;
+    fit1_params = fit2_params = s.params;
 
 
     float JTJ[COMPASS_CAL_NUM_ELLIPSOID_PARAMS*COMPASS_CAL_NUM_ELLIPSOID_PARAMS] = { };
@@ -627,39 +876,45 @@ void CompassCalibrator::run_ellipsoid_fit()
     float JTFI[COMPASS_CAL_NUM_ELLIPSOID_PARAMS] = { };
 
     // Gauss Newton Part common for all kind of extensions including LM
-    for(uint16_t k = 0; k<_samples_collected; k++) {
-        Vector3f sample = _sample_buffer[k].get();
+    for(uint16_t k = 0; k<s.num_samples; k++) {
+        Vector3f sample = s.samples[k].get();
 
         float ellipsoid_jacob[COMPASS_CAL_NUM_ELLIPSOID_PARAMS];
 
         calc_ellipsoid_jacob(sample, fit1_params, ellipsoid_jacob);
+        const float residual = calc_residual(sample, fit1_params);
 
         for(uint8_t i = 0;i < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; i++) {
-            // compute JTJ
-            for(uint8_t j = 0; j < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; j++) {
+            // compute JTJ, upper triangle only as it is symmetric
+            for(uint8_t j = i; j < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; j++) {
                 JTJ [i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+j] += ellipsoid_jacob[i] * ellipsoid_jacob[j];
-                JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+j] += ellipsoid_jacob[i] * ellipsoid_jacob[j];
             }
             // compute JTFI
-            JTFI[i] += ellipsoid_jacob[i] * calc_residual(sample, fit1_params);
+            JTFI[i] += ellipsoid_jacob[i] * residual;
+        }
+    }
+    for(uint8_t i = 0; i < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; i++) {
+        for(uint8_t j = 0; j < i; j++) {
+            JTJ[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+j] = JTJ[j*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i];
         }
     }
+    memcpy(JTJ2, JTJ, sizeof(JTJ2));
 
 
 
     //------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
     //refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
     for(uint8_t i = 0; i < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; i++) {
-        JTJ[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += _ellipsoid_lambda;
-        JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += _ellipsoid_lambda/lma_damping;
+        JTJ[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += s.lambda;
+        JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += s.lambda/lma_damping;
     }
 
     if(!inverse(JTJ, JTJ, 9)) {
-        return;
+        return false;
     }
 
     if(!inverse(JTJ2, JTJ2, 9)) {
-        return;
+        return false;
     }
 
     for(uint8_t row=0; row < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; row++) {
@@ -669,25 +924,27 @@ void CompassCalibrator::run_ellipsoid_fit()
         }
     }
 
-    fit1 = calc_mean_squared_residuals(fit1_params);
-    fit2 = calc_mean_squared_residuals(fit2_params);
+    fit1 = calc_mean_squared_residuals(fit1_params, s.samples, s.num_samples);
+    fit2 = calc_mean_squared_residuals(fit2_params, s.samples, s.num_samples);
 
-    if(fit1 > _fitness && fit2 > _fitness){
-        _ellipsoid_lambda *= lma_damping;
-    } else if(fit2 < _fitness && fit2 < fit1) {
-        _ellipsoid_lambda /= lma_damping;
+    if(fit1 > s.fitness && fit2 > s.fitness){
+        s.lambda *= lma_damping;
+    } else if(fit2 < s.fitness && fit2 < fit1) {
+        s.lambda /= lma_damping;
         fit1_params = fit2_params;
         fitness = fit2;
-    } else if(fit1 < _fitness){
+    } else if(fit1 < s.fitness){
         fitness = fit1;
     }
     //--------------------Levenberg-part-ends-here--------------------------------//
 
-    if(fitness < _fitness) {
-        _fitness = fitness;
-        _params = fit1_params;
-        update_completion_mask();
+    if(fitness < s.fitness) {
+        s.fitness = fitness;
+        s.params = fit1_params;
+        calc_completion_mask(s.samples, s.num_samples, s.params, s.completion_mask);
+        return true;
     }
+    return false;
 }
 
 
@@ -888,8 +1145,8 @@ bool CompassCalibrator::calculate_orientation(void)
     // re-run the fit to get the diagonals and off-diagonals for the
     // new orientation
     initialize_fit();
-    run_sphere_fit();
-    run_ellipsoid_fit();
+    run_fit_now(FIT_SPHERE);
+    run_fit_now(FIT_ELLIPSOID);
     
     return fit_acceptable();
 }
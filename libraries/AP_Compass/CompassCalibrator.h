@@ -1,10 +1,13 @@
 #pragma once
 
+#include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 
 #define COMPASS_CAL_NUM_SPHERE_PARAMS 4
 #define COMPASS_CAL_NUM_ELLIPSOID_PARAMS 9
 #define COMPASS_CAL_NUM_SAMPLES 300
+// samples classified into geodesic sections per call when rebuilding the completion mask
+#define COMPASS_CAL_SECTION_BATCH 16
 
 //RMS tolerance
 #define COMPASS_CAL_DEFAULT_TOLERANCE 5.0f
@@ -45,17 +48,34 @@ public:
     
     void set_tolerance(float tolerance) { _tolerance = tolerance; }
 
-    void get_calibration(Vector3f &offsets, Vector3f &diagonals, Vector3f &offdiagonals);
+    void get_calibration(Vector3f &offsets, Vector3f &diagonals, Vector3f &offdiagonals) const;
     enum Rotation get_orientation(void) { return _orientation; }
     enum Rotation get_original_orientation(void) { return _orig_orientation; }
 
     float get_completion_percent() const;
-    completion_mask_t& get_completion_mask();
+    void get_completion_mask(completion_mask_t &mask) const;
     enum compass_cal_status_t get_status() const { return _status; }
-    float get_fitness() const { return sqrtf(_fitness); }
+    float get_fitness() const;
     float get_orientation_confidence() const { return _orientation_confidence; }
     uint8_t get_attempt() const { return _attempt; }
 
+    /*
+      create the semaphore the fit state is shared with a fit thread
+      under. It must be created before the thread is started
+     */
+    bool create_fit_semaphore();
+
+    /*
+      when enabled, update() hands each fit iteration to
+      run_pending_fit(), which the caller runs on another thread. The
+      thread runs the iteration on a copy of the fit state and copies
+      the result back under the fit semaphore
+     */
+    void set_fit_thread(bool enable) { _use_fit_thread = enable && _fit_sem != nullptr; }
+
+    // run the pending fit iteration, if any. Returns true if one was run
+    bool run_pending_fit();
+
 private:
     class param_t {
     public:
@@ -129,6 +149,60 @@ private:
     uint16_t _samples_thinned;
     float _orientation_confidence;
 
+    /*
+      normal equations of the algebraic sphere fit
+      |p|^2 = 2*c.p + k, accumulated as samples are added and removed so
+      the first fit step can start from the least squares centre and
+      radius. Samples are taken relative to the first sample to keep
+      the sums well conditioned
+     */
+    struct {
+        Vector3f origin;
+        float ATA[4*4];
+        float ATb[4];
+    } _sphere_sums;
+    void sphere_sums_update(const Vector3f &sample, float sign);
+    bool sphere_sums_solve(Vector3f &offset, float &radius) const;
+
+    // fit iteration handed to the fit thread
+    enum fit_type_t : uint8_t {
+        FIT_NONE = 0,
+        FIT_SPHERE,
+        FIT_ELLIPSOID,
+    };
+
+    // copy of the fit state one iteration runs on
+    struct fit_state {
+        const CompassSample *samples;
+        uint16_t num_samples;
+        param_t params;
+        float fitness;
+        float lambda;
+        completion_mask_t completion_mask;
+    };
+
+    /*
+      the fit thread only touches the fit state holding _fit_sem, to
+      copy it before an iteration and to copy the results back after
+      it. The main thread does not change the fit state while a fit is
+      pending, except to cancel it, and reads the results the fit
+      thread writes under _fit_sem. A cancelled fit leaves the sample
+      buffer to the fit thread to free
+     */
+    AP_HAL::Semaphore *_fit_sem;
+    fit_type_t _fit_pending;
+    bool _fit_running;
+    bool _fit_cancelled;
+    bool _use_fit_thread;
+    void fit_lock() const;
+    void fit_unlock() const;
+    void get_fit_state(fit_type_t type, fit_state &s) const;
+    void set_fit_state(fit_type_t type, const fit_state &s, bool improved);
+    bool run_fit(fit_type_t type, fit_state &s) const;
+    void run_fit_now(fit_type_t type);
+    void request_fit(fit_type_t type);
+    void cancel_fit();
+
     bool set_status(compass_cal_status_t status);
 
     // returns true if sample should be added to buffer
@@ -149,13 +223,14 @@ private:
     float calc_residual(const Vector3f& sample, const param_t& params) const;
     float calc_mean_squared_residuals(const param_t& params) const;
     float calc_mean_squared_residuals() const;
+    float calc_mean_squared_residuals(const param_t& params, const CompassSample *samples, uint16_t num_samples) const;
 
     void calc_initial_offset();
     void calc_sphere_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
-    void run_sphere_fit();
+    bool run_sphere_fit(fit_state &s) const;
 
     void calc_ellipsoid_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
-    void run_ellipsoid_fit();
+    bool run_ellipsoid_fit(fit_state &s) const;
 
     /**
      * Update #_completion_mask for the geodesic section of \p v. Corrections
@@ -168,6 +243,12 @@ private:
      * Reset and update #_completion_mask with the current samples.
      */
     void update_completion_mask();
+    /**
+     * Calculate the completion mask of \p num_samples samples corrected
+     * with \p params.
+     */
+    void calc_completion_mask(const CompassSample *samples, uint16_t num_samples,
+                              const param_t &params, completion_mask_t &mask) const;
 
     Vector3f calculate_earth_field(CompassSample &sample, enum Rotation r);
     bool calculate_orientation();
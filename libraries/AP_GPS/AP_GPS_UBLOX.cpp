@@ -350,7 +350,6 @@ AP_GPS_UBLOX::_request_port(void)
 bool
 AP_GPS_UBLOX::read(void)
 {
-    uint8_t data;
     int16_t numc;
     bool parsed = false;
     uint32_t millis_now = AP_HAL::millis();
@@ -380,102 +379,139 @@ AP_GPS_UBLOX::read(void)
         }
     }
 
+    // header and checksum bytes are read from the port in chunks and
+    // parsed by _parse_span(). Payload bytes not already in a chunk are
+    // read straight into _buffer
+    uint8_t rx_buf[64];
     numc = port->available();
-    for (int16_t i = 0; i < numc; i++) {        // Process bytes received
+    while (numc > 0) {
+        uint16_t n;
+        if (_step == 6) {
+            n = port->read(&_buffer[_payload_counter], MIN((uint16_t)numc, (uint16_t)(_payload_length - _payload_counter)));
+            _payload_counter += n;
+            if (_payload_counter == _payload_length) {
+                _step++;
+            }
+        } else {
+            n = port->read(rx_buf, MIN((uint16_t)numc, sizeof(rx_buf)));
+            if (_parse_span(rx_buf, n)) {
+                parsed = true;
+            }
+        }
+        if (n == 0) {
+            break;
+        }
+        numc -= n;
+    }
+    return parsed;
+}
 
-        // read the next byte
-        data = port->read();
+// Parse a span of received bytes, returning true if a navigation
+// solution was completed.
+//
+// If we fail to match any of the expected preamble or checksum bytes
+// we reset the state machine and re-consider the failed byte as the
+// first byte of the preamble.  This improves our chances of recovering
+// from a mismatch and makes it less likely that we will be fooled by
+// the preamble appearing as data in some other message.
+bool
+AP_GPS_UBLOX::_parse_span(const uint8_t *data, uint16_t len)
+{
+    bool parsed = false;
+    uint16_t ofs = 0;
 
-	reset:
-        switch(_step) {
+    while (ofs < len) {
+        switch (_step) {
 
         // Message preamble detection
         //
-        // If we fail to match any of the expected bytes, we reset
-        // the state machine and re-consider the failed byte as
-        // the first byte of the preamble.  This improves our
-        // chances of recovering from a mismatch and makes it less
-        // likely that we will be fooled by the preamble appearing
-        // as data in some other message.
-        //
+        case 0: {
+            const uint8_t *preamble = (const uint8_t *)memchr(&data[ofs], PREAMBLE1, len - ofs);
+            if (preamble == nullptr) {
+                return parsed;
+            }
+            ofs = (preamble - data) + 1;
+            _step++;
+            break;
+        }
         case 1:
-            if (PREAMBLE2 == data) {
-                _step++;
+            if (data[ofs] != PREAMBLE2) {
+                _step = 0;
+                Debug("reset %u", __LINE__);
                 break;
             }
-            _step = 0;
-            Debug("reset %u", __LINE__);
-            FALLTHROUGH;
-        case 0:
-            if(PREAMBLE1 == data)
-                _step++;
+            ofs++;
+            _step++;
             break;
 
         // Message header processing
         //
-        // We sniff the class and message ID to decide whether we
-        // are going to gather the message bytes or just discard
-        // them.
-        //
         // We always collect the length so that we can avoid being
         // fooled by preamble bytes in messages.
         //
         case 2:
+            _class = data[ofs++];
             _step++;
-            _class = data;
-            _ck_b = _ck_a = data;                               // reset the checksum accumulators
             break;
         case 3:
+            _msg_id = data[ofs++];
             _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
-            _msg_id = data;
             break;
         case 4:
+            _payload_length = data[ofs++];              // payload length low byte
             _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
-            _payload_length = data;                             // payload length low byte
             break;
         case 5:
-            _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
-
-            _payload_length += (uint16_t)(data<<8);
+            _payload_length |= (uint16_t)(data[ofs] << 8);
             if (_payload_length > sizeof(_buffer)) {
                 Debug("large payload %u", (unsigned)_payload_length);
                 // assume any payload bigger then what we know about is noise
                 _payload_length = 0;
                 _step = 0;
-				goto reset;
+                break;
             }
-            _payload_counter = 0;                               // prepare to receive payload
+            ofs++;
+            _payload_counter = 0;                       // prepare to receive payload
+            _step = (_payload_length == 0) ? 7 : 6;
             break;
 
         // Receive message data
         //
-        case 6:
-            _ck_b += (_ck_a += data);                   // checksum byte
-            if (_payload_counter < sizeof(_buffer)) {
-                _buffer[_payload_counter] = data;
-            }
-            if (++_payload_counter == _payload_length)
+        case 6: {
+            const uint16_t n = MIN((uint16_t)(len - ofs), (uint16_t)(_payload_length - _payload_counter));
+            memcpy(&_buffer[_payload_counter], &data[ofs], n);
+            ofs += n;
+            _payload_counter += n;
+            if (_payload_counter == _payload_length) {
                 _step++;
+            }
             break;
+        }
 
         // Checksum and message processing
         //
-        case 7:
-            _step++;
-            if (_ck_a != data) {
-                Debug("bad cka %x should be %x", data, _ck_a);
+        // The checksum covers the class, id, length and payload and is
+        // computed in one pass once the whole frame has arrived
+        //
+        case 7: {
+            uint8_t header[4] { _class, _msg_id, (uint8_t)(_payload_length & 0xFF), (uint8_t)(_payload_length >> 8) };
+            _ck_a = _ck_b = 0;
+            _update_checksum(header, sizeof(header), _ck_a, _ck_b);
+            _update_checksum(&_buffer[0], _payload_length, _ck_a, _ck_b);
+            if (_ck_a != data[ofs]) {
+                Debug("bad cka %x should be %x", data[ofs], _ck_a);
                 _step = 0;
-				goto reset;
+                break;
             }
+            ofs++;
+            _step++;
             break;
+        }
         case 8:
             _step = 0;
-            if (_ck_b != data) {
-                Debug("bad ckb %x should be %x", data, _ck_b);
-                break;                                                  // bad checksum
+            if (_ck_b != data[ofs++]) {
+                Debug("bad ckb %x should be %x", data[ofs-1], _ck_b);
+                break;                                  // bad checksum
             }
 
             if (_parse_gps()) {
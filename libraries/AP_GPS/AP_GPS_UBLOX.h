@@ -567,6 +567,7 @@ private:
     
     bool havePvtMsg;
 
+    bool        _parse_span(const uint8_t *data, uint16_t len);
     bool        _configure_message_rate(uint8_t msg_class, uint8_t msg_id, uint8_t rate);
     void        _configure_rate(void);
     void        _configure_sbas(bool enable);
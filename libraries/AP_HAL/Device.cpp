@@ -17,6 +17,11 @@
 
 #include <stdio.h>
 
+#include "system.h"
+
+AP_HAL::Device::BusStats AP_HAL::Device::_bus_stats[HAL_DEVICE_STATS_MAX];
+std::atomic<uint8_t> AP_HAL::Device::_num_bus_stats;
+
 /*
   using checked registers allows a device check that a set of critical
   register values don't change at runtime. This is useful on key
@@ -108,3 +113,87 @@ bool AP_HAL::Device::check_next_register(void)
     _checked.next = (_checked.next+1) % _checked.n_set;
     return true;
 }
+
+/*
+  find the statistics entry for a bus address, claiming a new one if
+  this is the first transfer to it. Transfers to one address are
+  serialised by the bus semaphore, so only entries for different buses
+  can be claimed at the same time. A zero bus_id marks an entry that
+  is claimed but not yet filled in
+ */
+AP_HAL::Device::BusStats *AP_HAL::Device::find_bus_stats(uint32_t bus_id)
+{
+    const uint8_t n = num_bus_stats();
+    for (uint8_t i=0; i<n; i++) {
+        if (_bus_stats[i].bus_id == bus_id) {
+            return &_bus_stats[i];
+        }
+    }
+    const uint8_t idx = _num_bus_stats.fetch_add(1);
+    if (idx >= HAL_DEVICE_STATS_MAX) {
+        // table is full, don't let the count wrap
+        _num_bus_stats.store(HAL_DEVICE_STATS_MAX);
+        return nullptr;
+    }
+    _bus_stats[idx].bus_id = bus_id;
+    return &_bus_stats[idx];
+}
+
+AP_HAL::Device::BusStats *AP_HAL::Device::stats_entry(void)
+{
+    // drivers may change the address of an I2C device while probing
+    const uint32_t id = change_bus_id(get_bus_id(), 0);
+    if (_stats == nullptr || _stats->bus_id != id) {
+        _stats = find_bus_stats(id);
+    }
+    return _stats;
+}
+
+void AP_HAL::Device::record_transfer(uint32_t start_us, uint32_t len, bool ok)
+{
+    const uint32_t dt = AP_HAL::micros() - start_us;
+
+    if (stats_entry() == nullptr) {
+        return;
+    }
+
+    _stats->transfers++;
+    if (!ok) {
+        _stats->failures++;
+    }
+    _stats->bytes += len;
+    _stats->busy_us += dt;
+    if (dt > _stats->max_us) {
+        _stats->max_us = dt;
+    }
+    uint8_t bin = 0;
+    for (uint32_t limit = 32; bin < HAL_DEVICE_STATS_HIST_BINS-1 && dt >= limit; limit <<= 1) {
+        bin++;
+    }
+    _stats->hist[bin]++;
+}
+
+void AP_HAL::Device::record_deadline(uint32_t late_us, uint32_t missed)
+{
+    if (stats_entry() == nullptr) {
+        return;
+    }
+    if (late_us > _stats->max_late_us) {
+        _stats->max_late_us = late_us;
+    }
+    _stats->missed_deadlines += missed;
+}
+
+uint8_t AP_HAL::Device::num_bus_stats(void)
+{
+    const uint8_t n = _num_bus_stats.load();
+    return n < HAL_DEVICE_STATS_MAX ? n : HAL_DEVICE_STATS_MAX;
+}
+
+const AP_HAL::Device::BusStats *AP_HAL::Device::get_bus_stats(uint8_t idx)
+{
+    if (idx >= num_bus_stats() || _bus_stats[idx].bus_id == 0) {
+        return nullptr;
+    }
+    return &_bus_stats[idx];
+}
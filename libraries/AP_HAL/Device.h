@@ -16,11 +16,19 @@
  */
 #pragma once
 
+#include <atomic>
 #include <inttypes.h>
 
 #include "AP_HAL_Namespace.h"
 #include "utility/functor.h"
 
+// number of bus addresses transfer statistics are kept for
+#ifndef HAL_DEVICE_STATS_MAX
+#define HAL_DEVICE_STATS_MAX 24
+#endif
+
+#define HAL_DEVICE_STATS_HIST_BINS 8
+
 /*
  * This is an interface abstracting I2C and SPI devices
  */
@@ -260,9 +268,47 @@ public:
     /* set number of retries on transfers */
     virtual void set_retries(uint8_t retries) {};
 
+    /*
+      transfer statistics for one bus address. All devices at the same
+      address share an entry, so the counts are kept when a driver
+      deletes its device after a failed probe
+     */
+    struct BusStats {
+        uint32_t bus_id;    // bus id with the device type cleared
+        uint32_t transfers;
+        uint32_t failures;
+        uint32_t bytes;
+        uint64_t busy_us;   // total time spent in transfers
+        uint32_t max_us;    // longest transfer
+        uint32_t max_late_us;       // worst periodic callback lateness
+        uint32_t missed_deadlines;  // callback periods skipped entirely
+        // transfer times, bin n counts transfers shorter than 32<<n
+        // microseconds and the last bin counts all longer transfers
+        uint32_t hist[HAL_DEVICE_STATS_HIST_BINS];
+    };
+
+    /*
+      record how late a periodic callback for this device ran, and how
+      many whole periods it missed. Called by bus schedulers with the
+      bus semaphore held
+     */
+    void record_deadline(uint32_t late_us, uint32_t missed);
+
+    // number of bus addresses with statistics
+    static uint8_t num_bus_stats(void);
+
+    // statistics for one bus address, or nullptr if idx is out of range
+    static const BusStats *get_bus_stats(uint8_t idx);
+
 protected:
     uint8_t _read_flag = 0;
 
+    /*
+      record a finished transfer of len bytes which started at
+      start_us. Backends call this from their transfer functions
+     */
+    void record_transfer(uint32_t start_us, uint32_t len, bool ok);
+
     /*
       broken out device elements. The bitfields are used to keep
       the overall value small enough to fit in a float accurately,
@@ -307,4 +353,15 @@ private:
         uint8_t counter;
         struct checkreg *regs;
     } _checked;
+
+    BusStats *_stats = nullptr;
+
+    // statistics entry for the current address of this device
+    BusStats *stats_entry(void);
+
+    static BusStats *find_bus_stats(uint32_t bus_id);
+
+    // entries are claimed from any bus thread, and never released
+    static BusStats _bus_stats[HAL_DEVICE_STATS_MAX];
+    static std::atomic<uint8_t> _num_bus_stats;
 };
@@ -50,6 +50,21 @@ public:
      */
     virtual void     write(uint8_t ch, uint16_t period_us) = 0;
 
+    /*
+     * Output a set of channels in one call. period_us is indexed by
+     * channel number and only the channels in chmask are written. Backends
+     * that talk to the hardware over a bus override this so the channels go
+     * out in a single transaction even when not corked. The default writes
+     * the channels one at a time.
+     */
+    virtual void     write_mask(uint32_t chmask, const uint16_t *period_us) {
+        for (uint8_t ch = 0; chmask != 0; ch++, chmask >>= 1) {
+            if (chmask & 1U) {
+                write(ch, period_us[ch]);
+            }
+        }
+    }
+
     /*
      * Delay subsequent calls to write() going to the underlying hardware in
      * order to group related writes together. When all the needed writes are
@@ -18,3 +18,17 @@ public:
     virtual bool give() = 0;
     virtual ~Semaphore(void) {}
 };
+
+/*
+  a semaphore one thread waits on until another thread signals it,
+  to wake a thread when there is work for it. Signals made while
+  nothing is waiting are remembered, but only as one
+ */
+class AP_HAL::BinarySemaphore {
+public:
+    // wait up to timeout_us for a signal, returns false on timeout
+    virtual bool wait(uint32_t timeout_us) WARN_IF_UNUSED = 0;
+
+    virtual void signal() = 0;
+    virtual ~BinarySemaphore(void) {}
+};
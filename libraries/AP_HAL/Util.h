@@ -123,6 +123,9 @@ public:
     // create a new semaphore
     virtual Semaphore *new_semaphore(void) { return nullptr; }
 
+    // create a new binary semaphore, for waking one thread from another
+    virtual BinarySemaphore *new_binary_semaphore(void) { return nullptr; }
+
     // allocate and free DMA-capable memory if possible. Otherwise return normal memory
     enum Memory_Type {
         MEM_DMA_SAFE,
@@ -43,6 +43,11 @@ public:
      * -1 if nothing available, uint8_t value otherwise. */
     virtual int16_t read() = 0;
 
+    /* read up to count bytes into buffer, returning the number of
+     * bytes read. Drivers with a receive ring buffer should override
+     * this to copy in bulk rather than byte by byte */
+    virtual size_t read(uint8_t *buffer, size_t count);
+
     /* NB txspace was traditionally a member of BetterStream in the
      * FastSerial library. As far as concerns go, it belongs with available() */
     virtual uint32_t txspace() = 0;
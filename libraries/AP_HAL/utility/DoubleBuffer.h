@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/*
+  lock-free double buffer for passing the latest value of an object
+  from one writer thread to any number of reader threads.
+
+  The writer alternates between two slots and publishes the count of
+  completed writes. A slot is only rewritten two writes after it was
+  published, so a reader that finishes copying a slot before then has
+  a consistent value. A reader that was overtaken retries, which can
+  only happen if the writer completes two writes during one read. A
+  high priority reader on a single core never has to retry, and the
+  writer never waits.
+ */
+template <class T>
+class DoubleBuffer {
+public:
+    // publish a new value. Only one thread may write
+    void write(const T &object) {
+        const uint32_t n = published.load(std::memory_order_relaxed) + 1;
+        // announce the write before touching the slot
+        writing.store(n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        buffer[n & 1] = object;
+        published.store(n, std::memory_order_release);
+    }
+
+    // get the last published value, returns false if nothing has
+    // been written yet
+    bool read(T &object) const {
+        while (true) {
+            const uint32_t n = published.load(std::memory_order_acquire);
+            if (n == 0) {
+                return false;
+            }
+            object = buffer[n & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (writing.load(std::memory_order_relaxed) - n < 2) {
+                return true;
+            }
+        }
+    }
+
+    // number of values published so far
+    uint32_t count(void) const {
+        return published.load(std::memory_order_acquire);
+    }
+
+private:
+    T buffer[2];
+    std::atomic<uint32_t> writing{0};   // number of the write in progress or last completed
+    std::atomic<uint32_t> published{0}; // number of the last completed write
+};
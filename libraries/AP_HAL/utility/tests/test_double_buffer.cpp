@@ -0,0 +1,80 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <AP_gtest.h>
+
+#include <thread>
+#include <AP_HAL/utility/DoubleBuffer.h>
+
+struct TestObject {
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+TEST(DoubleBufferTest, Empty)
+{
+    DoubleBuffer<TestObject> buf;
+    TestObject obj;
+
+    EXPECT_FALSE(buf.read(obj));
+    EXPECT_EQ(0U, buf.count());
+}
+
+TEST(DoubleBufferTest, ReadLatest)
+{
+    DoubleBuffer<TestObject> buf;
+    TestObject obj;
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        buf.write(TestObject{i, 2*i, 3*i});
+        ASSERT_TRUE(buf.read(obj));
+        EXPECT_EQ(i, obj.a);
+        EXPECT_EQ(2*i, obj.b);
+        EXPECT_EQ(3*i, obj.c);
+        EXPECT_EQ(i, buf.count());
+    }
+
+    // reads do not consume the value
+    ASSERT_TRUE(buf.read(obj));
+    EXPECT_EQ(5U, obj.a);
+}
+
+TEST(DoubleBufferTest, ConcurrentReadsAreConsistent)
+{
+    DoubleBuffer<TestObject> buf;
+    const uint32_t writes = 200000;
+
+    std::thread writer([&buf, writes]() {
+        for (uint32_t i = 1; i <= writes; i++) {
+            buf.write(TestObject{i, ~i, i * 7});
+        }
+    });
+
+    uint32_t last = 0;
+    while (last < writes) {
+        TestObject obj;
+        if (!buf.read(obj)) {
+            continue;
+        }
+        ASSERT_EQ(~obj.a, obj.b);
+        ASSERT_EQ(obj.a * 7, obj.c);
+        ASSERT_GE(obj.a, last);
+        last = obj.a;
+    }
+
+    writer.join();
+}
+
+AP_GTEST_MAIN()
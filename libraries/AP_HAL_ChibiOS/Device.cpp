@@ -16,6 +16,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/utility/OwnPtr.h>
+#include <AP_Math/AP_Math.h>
 #include <stdio.h>
 #include "Scheduler.h"
 #include "Semaphores.h"
@@ -35,6 +36,113 @@ DeviceBus::DeviceBus(uint8_t _thread_priority) :
     bouncebuffer_init(&bounce_buffer_rx, 10);
 }
 
+/*
+  callbacks due within this window of the earliest are run in the same
+  pass. Waking again for them would cost at least the minimum thread
+  delay, so running them early gives less jitter than running them late
+ */
+#define DEVICE_BUS_COALESCE_USEC 100
+
+/*
+  add a callback to the list, keeping it in deadline order
+ */
+void DeviceBus::insert_callback(callback_info *callback)
+{
+    callback_info **p = &callbacks;
+    while (*p != nullptr && (*p)->next_usec <= callback->next_usec) {
+        p = &(*p)->next;
+    }
+    callback->next = *p;
+    *p = callback;
+}
+
+bool DeviceBus::remove_callback(callback_info *callback)
+{
+    for (callback_info **p = &callbacks; *p != nullptr; p = &(*p)->next) {
+        if (*p == callback) {
+            *p = callback->next;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+  move newly registered callbacks onto the bus timeline. A callback
+  whose period is a multiple or a divisor of one already on the bus is
+  phase aligned with it, so the two fall due together and share a
+  semaphore take and a thread wakeup instead of leaving gaps between
+  them
+ */
+void DeviceBus::add_pending_callbacks(void)
+{
+    chSysLock();
+    callback_info *list = pending;
+    pending = nullptr;
+    chSysUnlock();
+
+    while (list != nullptr) {
+        callback_info *callback = list;
+        list = list->next;
+
+        for (callback_info *ref = callbacks; ref != nullptr; ref = ref->next) {
+            const uint32_t step = MIN(ref->period_usec, callback->period_usec);
+            const uint32_t longer = MAX(ref->period_usec, callback->period_usec);
+            if (step == 0 || longer % step != 0) {
+                continue;
+            }
+            // first point at or after the requested start on the
+            // grid of the reference callback
+            const uint64_t target = callback->next_usec;
+            if (target > ref->next_usec) {
+                callback->next_usec = ref->next_usec + ((target - ref->next_usec + step - 1) / step) * step;
+            } else {
+                callback->next_usec = ref->next_usec - ((ref->next_usec - target) / step) * step;
+            }
+            break;
+        }
+        insert_callback(callback);
+    }
+}
+
+/*
+  run the callbacks that are due, holding the bus semaphore once for
+  all of them. Lateness and skipped periods are recorded against each
+  callback's device
+ */
+void DeviceBus::run_callbacks(uint64_t now)
+{
+    if (callbacks == nullptr || callbacks->next_usec > now + DEVICE_BUS_COALESCE_USEC) {
+        return;
+    }
+    if (!semaphore.take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        return;
+    }
+    while (callbacks != nullptr && callbacks->next_usec <= now + DEVICE_BUS_COALESCE_USEC) {
+        callback_info *callback = callbacks;
+        callbacks = callback->next;
+
+        const uint64_t due = callback->next_usec;
+        uint32_t missed = 0;
+        callback->next_usec += callback->period_usec;
+        while (now >= callback->next_usec) {
+            callback->next_usec += callback->period_usec;
+            missed++;
+        }
+        if (callback->device != nullptr) {
+            callback->device->record_deadline(now > due ? now - due : 0, missed);
+        }
+
+        running = callback;
+        callback->cb();
+        running = nullptr;
+
+        insert_callback(callback);
+        now = AP_HAL::micros64();
+    }
+    semaphore.give();
+}
+
 /*
   per-bus callback thread
 */
@@ -43,35 +151,15 @@ void DeviceBus::bus_thread(void *arg)
     struct DeviceBus *binfo = (struct DeviceBus *)arg;
 
     while (true) {
-        uint64_t now = AP_HAL::micros64();
-        DeviceBus::callback_info *callback;
-
-        // find a callback to run
-        for (callback = binfo->callbacks; callback; callback = callback->next) {
-            if (now >= callback->next_usec) {
-                while (now >= callback->next_usec) {
-                    callback->next_usec += callback->period_usec;
-                }
-                // call it with semaphore held
-                if (binfo->semaphore.take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
-                    callback->cb();
-                    binfo->semaphore.give();
-                }
-            }
-        }
+        binfo->add_pending_callbacks();
+        binfo->run_callbacks(AP_HAL::micros64());
 
-        // work out when next loop is needed
+        // work out when next loop is needed, the list is in deadline
+        // order so this is the first callback
+        const uint64_t now = AP_HAL::micros64();
         uint64_t next_needed = 0;
-        now = AP_HAL::micros64();
-
-        for (callback = binfo->callbacks; callback; callback = callback->next) {
-            if (next_needed == 0 ||
-                callback->next_usec < next_needed) {
-                next_needed = callback->next_usec;
-                if (next_needed < now) {
-                    next_needed = now;
-                }
-            }
+        if (binfo->callbacks != nullptr) {
+            next_needed = MAX(binfo->callbacks->next_usec, now);
         }
 
         // delay for at most 50ms, to handle newly added callbacks
@@ -79,7 +167,7 @@ void DeviceBus::bus_thread(void *arg)
         if (next_needed >= now && next_needed - now < delay) {
             delay = next_needed - now;
         }
-        // don't delay for less than 400usec, so one thread doesn't
+        // don't delay for less than 100usec, so one thread doesn't
         // completely dominate the CPU
         if (delay < 100) {
             delay = 100;
@@ -129,10 +217,13 @@ AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t pe
     callback->cb = cb;
     callback->period_usec = period_usec;
     callback->next_usec = AP_HAL::micros64() + period_usec;
+    callback->device = _hal_device;
 
-    // add to linked list of callbacks on thread
-    callback->next = callbacks;
-    callbacks = callback;
+    // hand over to the bus thread, which places it on the timeline
+    chSysLock();
+    callback->next = pending;
+    pending = callback;
+    chSysUnlock();
 
     return callback;
 }
@@ -150,8 +241,14 @@ bool DeviceBus::adjust_timer(AP_HAL::Device::PeriodicHandle h, uint32_t period_u
 
     DeviceBus::callback_info *callback = static_cast<DeviceBus::callback_info *>(h);
 
+    // a callback adjusting itself is off the list while it runs, and
+    // one not yet on the timeline is placed when it is added
+    const bool listed = callback != running && remove_callback(callback);
     callback->period_usec = period_usec;
     callback->next_usec = AP_HAL::micros64() + period_usec;
+    if (listed) {
+        insert_callback(callback);
+    }
 
     return true;
 }
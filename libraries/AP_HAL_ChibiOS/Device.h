@@ -45,7 +45,22 @@ private:
         AP_HAL::Device::PeriodicCb cb;
         uint32_t period_usec;
         uint64_t next_usec;
-    } *callbacks;
+        AP_HAL::Device *device;
+    };
+
+    // callbacks in deadline order, owned by the bus thread
+    callback_info *callbacks;
+
+    // callbacks registered since the bus thread last looked
+    callback_info *pending;
+
+    // callback being run, which is not in the list
+    callback_info *running;
+
+    void insert_callback(callback_info *callback);
+    bool remove_callback(callback_info *callback);
+    void add_pending_callbacks(void);
+    void run_callbacks(uint64_t now);
     uint8_t thread_priority;
     thread_t* thread_ctx;
     bool thread_started;
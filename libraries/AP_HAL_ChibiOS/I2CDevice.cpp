@@ -212,6 +212,8 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
         return false;
     }
     
+    const uint32_t start_us = AP_HAL::micros();
+
     bus.dma_handle->lock();
 
 #if defined(STM32F7)
@@ -228,6 +230,7 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
     }
 #endif
 
+    bool ret = true;
     if (_split_transfers) {
         /*
           splitting the transfer() into two pieces avoids a stop condition
@@ -235,27 +238,19 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
           LidarLite blue label)
         */
         if (send && send_len) {
-            if (!_transfer(send, send_len, nullptr, 0)) {
-                bus.dma_handle->unlock();
-                return false;
-            }
+            ret = _transfer(send, send_len, nullptr, 0);
         }
-        if (recv && recv_len) {
-            if (!_transfer(nullptr, 0, recv, recv_len)) {
-                bus.dma_handle->unlock();
-                return false;
-            }
+        if (ret && recv && recv_len) {
+            ret = _transfer(nullptr, 0, recv, recv_len);
         }
     } else {
         // combined transfer
-        if (!_transfer(send, send_len, recv, recv_len)) {
-            bus.dma_handle->unlock();
-            return false;
-        }
+        ret = _transfer(send, send_len, recv, recv_len);
     }
 
     bus.dma_handle->unlock();
-    return true;
+    record_transfer(start_us, send_len + recv_len, ret);
+    return ret;
 }
 
 bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
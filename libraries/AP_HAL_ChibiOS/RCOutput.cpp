@@ -343,6 +343,26 @@ void RCOutput::write(uint8_t chan, uint16_t period_us)
     }
 }
 
+/*
+  write a set of channels, updating the timers and the IOMCU once for
+  the whole set
+ */
+void RCOutput::write_mask(uint32_t chmask, const uint16_t *period_us)
+{
+    const bool was_corked = corked;
+    if (!was_corked) {
+        cork();
+    }
+    for (uint8_t chan = 0; chan < max_channels; chan++) {
+        if (chmask & (1U<<chan)) {
+            write(chan, period_us[chan]);
+        }
+    }
+    if (!was_corked) {
+        push();
+    }
+}
+
 /*
   push values to local channels from period[] array
  */
@@ -223,9 +223,12 @@ bool SPIDevice::transfer(const uint8_t *send, uint32_t send_len,
         hal.console->printf("SPI: not owner of 0x%x\n", unsigned(get_bus_id()));
         return false;
     }
+    const uint32_t start_us = AP_HAL::micros();
     if ((send_len == recv_len && send == recv) || !send || !recv) {
         // simplest cases, needed for DMA
-        do_transfer(send, recv, recv_len?recv_len:send_len);
+        const uint32_t len = recv_len?recv_len:send_len;
+        do_transfer(send, recv, len);
+        record_transfer(start_us, len, true);
         return true;
     }
     uint8_t buf[send_len+recv_len];
@@ -239,16 +242,19 @@ bool SPIDevice::transfer(const uint8_t *send, uint32_t send_len,
     if (recv_len > 0) {
         memcpy(recv, &buf[send_len], recv_len);
     }
+    record_transfer(start_us, send_len+recv_len, true);
     return true;
 }
 
 bool SPIDevice::transfer_fullduplex(const uint8_t *send, uint8_t *recv, uint32_t len)
 {
     bus.semaphore.assert_owner();
+    const uint32_t start_us = AP_HAL::micros();
     uint8_t buf[len];
     memcpy(buf, send, len);
     do_transfer(buf, buf, len);
     memcpy(recv, buf, len);
+    record_transfer(start_us, len, true);
     return true;
 }
 
@@ -55,3 +55,24 @@ bool Semaphore::take_nonblocking()
 
 #endif // CH_CFG_USE_MUTEXES
 
+bool ChibiOS::BinarySemaphore::wait(uint32_t timeout_us)
+{
+    uint32_t ticks;
+    if (timeout_us >= 4096) {
+        // we need to use 64 bit calculations for tick conversions
+        ticks = US2ST64(timeout_us);
+    } else {
+        ticks = US2ST(timeout_us);
+    }
+    if (ticks == 0) {
+        // a timeout of zero ticks would not wait at all
+        ticks = 1;
+    }
+    return chBSemWaitTimeout(&_sem, ticks) == MSG_OK;
+}
+
+void ChibiOS::BinarySemaphore::signal()
+{
+    chBSemSignal(&_sem);
+}
+
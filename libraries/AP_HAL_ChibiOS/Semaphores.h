@@ -44,3 +44,15 @@ public:
 private:
     mutex_t _lock;
 };
+
+class ChibiOS::BinarySemaphore : public AP_HAL::BinarySemaphore {
+public:
+    BinarySemaphore() {
+        // start taken, so the first wait() blocks until a signal
+        chBSemObjectInit(&_sem, true);
+    }
+    bool wait(uint32_t timeout_us) override;
+    void signal() override;
+private:
+    binary_semaphore_t _sem;
+};
@@ -497,6 +497,23 @@ int16_t UARTDriver::read()
     return byte;
 }
 
+size_t UARTDriver::read(uint8_t *buffer, size_t count)
+{
+    if (_uart_owner_thd != chThdGetSelfX()){
+        return 0;
+    }
+    if (!_initialised) {
+        return 0;
+    }
+
+    const uint32_t ret = _readbuf.read(buffer, count);
+    if (ret > 0 && !_rts_is_active) {
+        update_rts_line();
+    }
+
+    return ret;
+}
+
 /* Empty implementations of Print virtual methods */
 size_t UARTDriver::write(uint8_t c)
 {
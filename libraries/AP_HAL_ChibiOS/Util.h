@@ -30,6 +30,7 @@ public:
 
     bool run_debug_shell(AP_HAL::BetterStream *stream) { return false; }
     AP_HAL::Semaphore *new_semaphore(void) override { return new ChibiOS::Semaphore; }
+    AP_HAL::BinarySemaphore *new_binary_semaphore(void) override { return new ChibiOS::BinarySemaphore; }
     uint32_t available_memory() override;
 
     // Special Allocation Routines
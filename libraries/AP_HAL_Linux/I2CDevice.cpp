@@ -190,12 +190,15 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
     i2c_data.msgs = msgs;
     i2c_data.nmsgs = nmsgs;
 
+    const uint32_t start_us = AP_HAL::micros();
     int r;
     unsigned retries = _retries;
     do {
         r = ::ioctl(_bus.fd, I2C_RDWR, &i2c_data);
     } while (r == -1 && retries-- > 0);
 
+    record_transfer(start_us, send_len + recv_len, r != -1);
+
     return r != -1;
 }
 
@@ -182,6 +182,27 @@ void RCOutput_PCA9685::write(uint8_t ch, uint16_t period_us)
     }
 }
 
+/*
+  update several channels and send them with a single auto-increment
+  register write, rather than one bus transfer per channel
+ */
+void RCOutput_PCA9685::write_mask(uint32_t chmask, const uint16_t *period_us)
+{
+    chmask &= (1U << (PWM_CHAN_COUNT - _channel_offset)) - 1;
+
+    for (uint8_t ch = 0; ch < (PWM_CHAN_COUNT - _channel_offset); ch++) {
+        if (chmask & (1U << ch)) {
+            _pulses_buffer[ch] = period_us[ch];
+        }
+    }
+    _pending_write_mask |= chmask;
+
+    if (!_corking) {
+        _corking = true;
+        push();
+    }
+}
+
 void RCOutput_PCA9685::cork()
 {
     _corking = true;
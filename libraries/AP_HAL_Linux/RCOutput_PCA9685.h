@@ -27,6 +27,7 @@ public:
     void     enable_ch(uint8_t ch);
     void     disable_ch(uint8_t ch);
     void     write(uint8_t ch, uint16_t period_us);
+    void     write_mask(uint32_t chmask, const uint16_t *period_us) override;
     void     cork() override;
     void     push() override;
     uint16_t read(uint8_t ch);
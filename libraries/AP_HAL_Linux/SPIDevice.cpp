@@ -321,9 +321,11 @@ bool SPIDevice::transfer(const uint8_t *send, uint32_t send_len,
         _bus.last_mode = _desc.mode;
     }
 
+    const uint32_t start_us = AP_HAL::micros();
     _cs_assert();
     r = ioctl(_bus.fd, SPI_IOC_MESSAGE(nmsgs), &msgs);
     _cs_release();
+    record_transfer(start_us, send_len + recv_len, r != -1);
 
     if (r == -1) {
         hal.console->printf("SPIDevice: error transferring data fd=%d (%s)\n",
@@ -360,9 +362,11 @@ bool SPIDevice::transfer_fullduplex(const uint8_t *send, uint8_t *recv,
         return false;
     }
 
+    const uint32_t start_us = AP_HAL::micros();
     _cs_assert();
     r = ioctl(_bus.fd, SPI_IOC_MESSAGE(1), &msgs);
     _cs_release();
+    record_transfer(start_us, len, r != -1);
 
     if (r == -1) {
         hal.console->printf("SPIDevice: error transferring data fd=%d (%s)\n",
@@ -20,4 +20,15 @@ private:
     pthread_mutex_t _lock;
 };
 
+class BinarySemaphore : public AP_HAL::BinarySemaphore {
+public:
+    BinarySemaphore();
+    bool wait(uint32_t timeout_us) override;
+    void signal() override;
+private:
+    pthread_mutex_t _lock;
+    pthread_cond_t _cond;
+    bool _pending;
+};
+
 }
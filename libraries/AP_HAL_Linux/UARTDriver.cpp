@@ -290,6 +290,15 @@ int16_t UARTDriver::read()
     return byte;
 }
 
+size_t UARTDriver::read(uint8_t *buffer, size_t count)
+{
+    if (!_initialised) {
+        return 0;
+    }
+
+    return _readbuf.read(buffer, count);
+}
+
 /* Linux implementations of Print virtual methods */
 size_t UARTDriver::write(uint8_t c)
 {
@@ -92,6 +92,7 @@ public:
 
     // create a new semaphore
     AP_HAL::Semaphore *new_semaphore(void) override { return new Semaphore; }
+    AP_HAL::BinarySemaphore *new_binary_semaphore(void) override { return new BinarySemaphore; }
 
     int get_hw_arm32();
 
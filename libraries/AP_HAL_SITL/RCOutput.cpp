@@ -55,6 +55,18 @@ void RCOutput::write(uint8_t ch, uint16_t period_us)
     }
 }
 
+void RCOutput::write_mask(uint32_t chmask, const uint16_t *period_us)
+{
+    _sitlState->output_ready = true;
+    chmask &= _enable_mask;
+    uint16_t *out = _corked ? _pending : _sitlState->pwm_output;
+    for (uint8_t ch = 0; ch < SITL_NUM_CHANNELS; ch++) {
+        if (chmask & (1U<<ch)) {
+            out[ch] = period_us[ch];
+        }
+    }
+}
+
 uint16_t RCOutput::read(uint8_t ch)
 {
     if (ch < SITL_NUM_CHANNELS) {
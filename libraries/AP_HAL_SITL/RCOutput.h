@@ -13,6 +13,7 @@ public:
     void enable_ch(uint8_t ch) override;
     void disable_ch(uint8_t ch) override;
     void write(uint8_t ch, uint16_t period_us) override;
+    void write_mask(uint32_t chmask, const uint16_t *period_us) override;
     uint16_t read(uint8_t ch) override;
     void read(uint16_t* period_us, uint8_t len) override;
     void cork(void);
@@ -20,6 +20,7 @@
 #include <AP_Compass/AP_Compass.h>
 #include <AP_Terrain/AP_Terrain.h>
 #include <SITL/SITL.h>
+#include <SITL/SIM_SensorPipeline.h>
 #include <SITL/SIM_Gimbal.h>
 #include <SITL/SIM_ADSB.h>
 #include <SITL/SIM_Vicon.h>
@@ -172,32 +173,13 @@ private:
     
     const char *_fg_address;
 
-    // delay buffer variables
-    static const uint8_t mag_buffer_length = 250;
-    static const uint8_t wind_buffer_length = 50;
+    // airspeed sensor noise and delay, one sample per sensor
+    SITL::NoiseSource _airspeed_noise;
+    SITL::SensorDelay<Vector2f, 50> _airspeed_delay{10};
+
+    // rangefinder noise and glitches
+    SITL::NoiseSource _sonar_noise;
 
-    // magnetometer delay buffer variables
-    struct readings_mag {
-        uint32_t time;
-        Vector3f data;
-    };
-    uint8_t store_index_mag;
-    uint32_t last_store_time_mag;
-    VectorN<readings_mag,mag_buffer_length> buffer_mag;
-    uint32_t time_delta_mag;
-    uint32_t delayed_time_mag;
-
-    // airspeed sensor delay buffer variables
-    struct readings_wind {
-        uint32_t time;
-        float data;
-    };
-    uint8_t store_index_wind;
-    uint32_t last_store_time_wind;
-    VectorN<readings_wind,wind_buffer_length> buffer_wind;
-    VectorN<readings_wind,wind_buffer_length> buffer_wind_2;
-    uint32_t time_delta_wind;
-    uint32_t delayed_time_wind;
     uint32_t wind_start_delay_micros;
 
     // internal SITL model
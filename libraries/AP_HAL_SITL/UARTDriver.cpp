@@ -151,6 +151,14 @@ int16_t UARTDriver::read(void)
     return c;
 }
 
+size_t UARTDriver::read(uint8_t *buffer, size_t count)
+{
+    if (available() <= 0) {
+        return 0;
+    }
+    return _readbuffer.read(buffer, count);
+}
+
 void UARTDriver::flush(void)
 {
 }
@@ -49,6 +49,7 @@ public:
     uint32_t available() override;
     uint32_t txspace() override;
     int16_t read() override;
+    size_t read(uint8_t *buffer, size_t count) override;
 
     /* Implementations of Print virtual methods */
     size_t write(uint8_t c);
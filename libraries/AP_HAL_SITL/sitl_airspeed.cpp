@@ -34,8 +34,8 @@ void SITL_State::_update_airspeed(float airspeed)
     airspeed = is_zero(_sitl->arspd_fail) ? airspeed : _sitl->arspd_fail;
     airspeed2 = is_zero(_sitl->arspd2_fail) ? airspeed2 : _sitl->arspd2_fail;
     // Add noise
-    airspeed = airspeed + (_sitl->arspd_noise * rand_float());
-    airspeed2 = airspeed2 + (_sitl->arspd_noise * rand_float());
+    airspeed = airspeed + (_sitl->arspd_noise * _airspeed_noise.next());
+    airspeed2 = airspeed2 + (_sitl->arspd_noise * _airspeed_noise.next());
 
     if (!is_zero(_sitl->arspd_fail_pressure)) {
         // compute a realistic pressure report given some level of trapper air pressure in the tube and our current altitude
@@ -67,40 +67,14 @@ void SITL_State::_update_airspeed(float airspeed)
         airspeed_2_pin_value = 0xFFFF;
         return;
     }
-    // add delay
+    // add delay, storing data every 10 ms and only using the stored
+    // state if it is within 200 msec of the delayed time
     const uint32_t now = AP_HAL::millis();
-    uint32_t best_time_delta_wind = 200;  // initialise large time representing buffer entry closest to current time - delay.
-    uint8_t best_index_wind = 0;  // initialise number representing the index of the entry in buffer closest to delay.
-
-    // storing data from sensor to buffer
-    if (now - last_store_time_wind >= 10) {  // store data every 10 ms.
-        last_store_time_wind = now;
-        if (store_index_wind > wind_buffer_length - 1) {  // reset buffer index if index greater than size of buffer
-            store_index_wind = 0;
-        }
-        buffer_wind[store_index_wind].data = airspeed_raw;  // add data to current index
-        buffer_wind[store_index_wind].time = last_store_time_wind;  // add time to current index
-        buffer_wind_2[store_index_wind].data = airspeed2_raw;  // add data to current index
-        buffer_wind_2[store_index_wind].time = last_store_time_wind;  // add time to current index
-        store_index_wind = store_index_wind + 1;  // increment index
-    }
-
-    // return delayed measurement
-    delayed_time_wind = now - _sitl->wind_delay;  // get time corresponding to delay
-    // find data corresponding to delayed time in buffer
-    for (uint8_t i = 0; i <= wind_buffer_length - 1; i++) {
-        // find difference between delayed time and time stamp in buffer
-        time_delta_wind = abs(
-                (int32_t)(delayed_time_wind - buffer_wind[i].time));
-        // if this difference is smaller than last delta, store this time
-        if (time_delta_wind < best_time_delta_wind) {
-            best_index_wind = i;
-            best_time_delta_wind = time_delta_wind;
-        }
-    }
-    if (best_time_delta_wind < 200) {  // only output stored state if < 200 msec retrieval error
-        airspeed_raw = buffer_wind[best_index_wind].data;
-        airspeed2_raw = buffer_wind_2[best_index_wind].data;
+    _airspeed_delay.push(now, Vector2f(airspeed_raw, airspeed2_raw));
+    Vector2f delayed;
+    if (_airspeed_delay.get(now, _sitl->wind_delay, 200, delayed)) {
+        airspeed_raw = delayed.x;
+        airspeed2_raw = delayed.y;
     }
 
     airspeed_pin_value = airspeed_raw / 4;
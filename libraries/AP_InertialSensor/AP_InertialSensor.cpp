@@ -1519,6 +1519,55 @@ check_sample:
 }
 
 
+/*
+  allocate the queue of gyro samples for a rate loop thread. The
+  backends push every filtered sample of the selected gyro and wake
+  the rate loop thread, which pops them with get_next_rate_loop_sample()
+ */
+bool AP_InertialSensor::init_rate_loop_samples(uint16_t length)
+{
+    if (_rate_loop_samples != nullptr) {
+        return true;
+    }
+    _rate_loop_sem = hal.util->new_semaphore();
+    _rate_loop_wake = hal.util->new_binary_semaphore();
+    if (_rate_loop_sem == nullptr || _rate_loop_wake == nullptr) {
+        return false;
+    }
+    _rate_loop_gyro = _primary_gyro;
+    _rate_loop_samples = new ObjectBuffer<rate_loop_sample>(length);
+    return _rate_loop_samples != nullptr;
+}
+
+/*
+  get the next gyro sample for the rate loop thread
+ */
+bool AP_InertialSensor::get_next_rate_loop_sample(Vector3f &gyro, float &dt)
+{
+    if (_rate_loop_samples == nullptr) {
+        return false;
+    }
+    rate_loop_sample sample;
+    if (!_rate_loop_samples->pop(sample)) {
+        return false;
+    }
+    // only the rate loop thread takes samples, so it owns the notch state
+    gyro = _notch_filter.apply(_rate_loop_notch, _gyro_raw_sample_rates[_rate_loop_gyro], sample.gyro);
+    dt = sample.dt;
+    return true;
+}
+
+/*
+  wait for the backends to queue a gyro sample for the rate loop thread
+ */
+bool AP_InertialSensor::wait_rate_loop_sample(uint32_t timeout_us)
+{
+    if (_rate_loop_wake == nullptr) {
+        return false;
+    }
+    return _rate_loop_wake->wait(timeout_us);
+}
+
 /*
   get delta angles
  */
@@ -25,6 +25,7 @@
 #include <Filter/LowPassFilter2p.h>
 #include <Filter/LowPassFilter.h>
 #include <Filter/NotchFilter.h>
+#include <AP_HAL/utility/RingBuffer.h>
 
 class AP_InertialSensor_Backend;
 class AuxiliaryBus;
@@ -182,6 +183,21 @@ public:
     // wait for a sample to be available
     void wait_for_sample(void);
 
+    // allocate a queue of filtered gyro samples at the sensor rate for
+    // a rate loop thread running apart from the main loop
+    bool init_rate_loop_samples(uint16_t length);
+
+    // select the gyro that is queued for the rate loop thread
+    void set_rate_loop_gyro(uint8_t instance) { _rate_loop_gyro = instance; }
+
+    // get the next gyro sample for the rate loop thread and the time in
+    // seconds it covers. Returns false if the queue is empty
+    bool get_next_rate_loop_sample(Vector3f &gyro, float &dt);
+
+    // block the rate loop thread until a gyro sample is queued, or for
+    // at most timeout_us. Returns false on timeout
+    bool wait_rate_loop_sample(uint32_t timeout_us);
+
     // class level parameters
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -407,6 +423,18 @@ private:
     // optional notch filter on gyro
     NotchFilterVector3fParam _notch_filter;
 
+    // filtered gyro samples queued for a rate loop thread. The notch
+    // filter is applied as they are taken, at the sensor rate
+    struct rate_loop_sample {
+        Vector3f gyro;
+        float dt;
+    };
+    ObjectBuffer<rate_loop_sample> *_rate_loop_samples;
+    AP_HAL::Semaphore *_rate_loop_sem;
+    AP_HAL::BinarySemaphore *_rate_loop_wake;
+    volatile uint8_t _rate_loop_gyro;
+    NotchFilterVector3fParam::stream _rate_loop_notch;
+
     // Most recent gyro reading
     Vector3f _gyro[INS_MAX_INSTANCES];
     Vector3f _delta_angle[INS_MAX_INSTANCES];
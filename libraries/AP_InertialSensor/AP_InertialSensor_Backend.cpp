@@ -232,6 +232,18 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
         _sem->give();
     }
 
+    if (_imu._rate_loop_samples != nullptr && instance == _imu._rate_loop_gyro && dt > 0) {
+        // the selected gyro can move to a backend on another bus
+        // thread, so keep to a single producer for the queue. A full
+        // queue means the rate loop thread is behind, so drop the sample
+        if (_imu._rate_loop_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+            const AP_InertialSensor::rate_loop_sample sample { _imu._gyro_filtered[instance], dt };
+            _imu._rate_loop_samples->push(sample);
+            _imu._rate_loop_sem->give();
+            _imu._rate_loop_wake->signal();
+        }
+    }
+
     log_gyro_raw(instance, sample_us, gyro);
 }
 
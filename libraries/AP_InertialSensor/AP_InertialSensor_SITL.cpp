@@ -65,9 +65,10 @@ void AP_InertialSensor_SITL::generate_accel(uint8_t instance)
 
     // add accel bias and noise
     Vector3f accel_bias = instance==0?sitl->accel_bias.get():sitl->accel2_bias.get();
-    float xAccel = sitl->state.xAccel + accel_noise * rand_float() + accel_bias.x;
-    float yAccel = sitl->state.yAccel + accel_noise * rand_float() + accel_bias.y;
-    float zAccel = sitl->state.zAccel + accel_noise * rand_float() + accel_bias.z;
+    const Vector3f n = noise.next_vec3f() * accel_noise;
+    float xAccel = sitl->state.xAccel + n.x + accel_bias.x;
+    float yAccel = sitl->state.yAccel + n.y + accel_bias.y;
+    float zAccel = sitl->state.zAccel + n.z + accel_bias.z;
 
     // correct for the acceleration due to the IMU position offset and angular acceleration
     // correct for the centripetal acceleration
@@ -115,15 +116,11 @@ void AP_InertialSensor_SITL::generate_gyro(uint8_t instance)
         gyro_noise += ToRad(sitl->gyro_noise);
     }
 
-    float p = radians(sitl->state.rollRate) + gyro_drift();
-    float q = radians(sitl->state.pitchRate) + gyro_drift();
-    float r = radians(sitl->state.yawRate) + gyro_drift();
-
-    p += gyro_noise * rand_float();
-    q += gyro_noise * rand_float();
-    r += gyro_noise * rand_float();
-
-    Vector3f gyro = Vector3f(p, q, r);
+    const float drift = gyro_drift();
+    Vector3f gyro = Vector3f(radians(sitl->state.rollRate) + drift,
+                             radians(sitl->state.pitchRate) + drift,
+                             radians(sitl->state.yawRate) + drift);
+    gyro += noise.next_vec3f() * gyro_noise;
 
     // add in gyro scaling
     Vector3f scale = sitl->gyro_scale;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SITL/SITL.h>
+#include <SITL/SIM_SensorPipeline.h>
 
 #include "AP_InertialSensor.h"
 #include "AP_InertialSensor_Backend.h"
@@ -35,4 +36,7 @@ private:
     uint8_t accel_instance[INS_SITL_INSTANCES];
     uint64_t next_gyro_sample[INS_SITL_INSTANCES];
     uint64_t next_accel_sample[INS_SITL_INSTANCES];
+
+    // noise for all sensors, drawn a block at a time
+    SITL::NoiseSource noise;
 };
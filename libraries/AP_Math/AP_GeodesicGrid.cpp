@@ -184,11 +184,127 @@ const Matrix3f AP_GeodesicGrid::_mid_inverses[10]{
      { 0.618034f,  0.000000f, -1.000000f}},
 };
 
+/* This was generated with
+ * libraries/AP_Math/tools/geodesic_grid/geodesic_grid.py */
+const uint8_t AP_GeodesicGrid::_lookup[6][LOOKUP_CELLS][LOOKUP_CELLS]{
+    {
+        { 5,  5,  5,  5,  5,  5,  4,  4,  4,  4, 19, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  5,  5,  4,  4, 19, 19, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  5,  5,  5, 19, 19, 19, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  5,  5,  6, 10, 19, 19, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  6,  6,  6,  6, 10, 10, 10, 10, 19, 19, 19, 19},
+        { 5,  5,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 19, 19},
+        { 6,  6,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 10, 10},
+        { 6,  6,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 10, 10},
+        { 6,  6,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 10, 10},
+        { 6,  6,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 10, 10},
+        { 7,  7,  6,  6,  6,  6,  6,  6, 10, 10, 10, 10, 10, 10, 11, 11},
+        { 7,  7,  7,  7,  6,  6,  6,  6, 10, 10, 10, 10, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7,  7,  6, 10, 11, 11, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7,  7,  7, 11, 11, 11, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7,  7, 12, 12, 11, 11, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7, 12, 12, 12, 12, 11, 11, 11, 11, 11, 11},
+    },
+    {
+        { 1,  1,  1,  1,  1,  1,  2,  2,  2,  2, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  1,  1,  2,  2, 17, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  1,  1,  1, 17, 17, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  1,  1,  0, 16, 17, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  0,  0,  0,  0, 16, 16, 16, 16, 17, 17, 17, 17},
+        { 1,  1,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 17, 17},
+        { 0,  0,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 16, 16},
+        { 0,  0,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 16, 16},
+        { 0,  0,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 16, 16},
+        { 0,  0,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 16, 16},
+        { 9,  9,  0,  0,  0,  0,  0,  0, 16, 16, 16, 16, 16, 16, 15, 15},
+        { 9,  9,  9,  9,  0,  0,  0,  0, 16, 16, 16, 16, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9,  9,  9,  0, 16, 15, 15, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9,  9,  9,  9, 15, 15, 15, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9,  9,  9, 14, 14, 15, 15, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9,  9, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15},
+    },
+    {
+        { 9,  9,  9,  9,  9,  9, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9,  9, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9,  9, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15},
+        { 9,  9,  9,  9, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15},
+        { 9,  9,  9,  9, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15},
+        { 8,  9,  9,  9, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 13},
+        { 8,  8,  9, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 13, 13},
+        { 8,  8,  7, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 11, 13, 13},
+        { 8,  7,  7,  7, 12, 12, 12, 12, 12, 12, 12, 12, 11, 11, 11, 13},
+        { 7,  7,  7,  7, 12, 12, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11},
+        { 7,  7,  7,  7, 12, 12, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7, 12, 12, 12, 12, 11, 11, 11, 11, 11, 11},
+        { 7,  7,  7,  7,  7,  7, 12, 12, 12, 12, 11, 11, 11, 11, 11, 11},
+    },
+    {
+        { 1,  1,  1,  1,  1,  1,  2,  2,  2,  2, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  1,  2,  2,  2,  2, 17, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  2,  2,  2,  2,  2,  2, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  1,  2,  2,  2,  2,  2,  2, 17, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  2,  2,  2,  2,  2,  2,  2,  2, 17, 17, 17, 17},
+        { 1,  1,  1,  1,  2,  2,  2,  2,  2,  2,  2,  2, 17, 17, 17, 17},
+        { 3,  1,  1,  1,  2,  2,  2,  2,  2,  2,  2,  2, 17, 17, 17, 18},
+        { 3,  3,  1,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2, 17, 18, 18},
+        { 3,  3,  5,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4, 19, 18, 18},
+        { 3,  5,  5,  5,  4,  4,  4,  4,  4,  4,  4,  4, 19, 19, 19, 18},
+        { 5,  5,  5,  5,  4,  4,  4,  4,  4,  4,  4,  4, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  4,  4,  4,  4,  4,  4,  4,  4, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  4,  4,  4,  4,  4,  4, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  4,  4,  4,  4,  4,  4, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  5,  4,  4,  4,  4, 19, 19, 19, 19, 19, 19},
+        { 5,  5,  5,  5,  5,  5,  4,  4,  4,  4, 19, 19, 19, 19, 19, 19},
+    },
+    {
+        {17, 17, 17, 17, 17, 17, 16, 16, 16, 16, 15, 15, 15, 15, 15, 15},
+        {17, 17, 17, 17, 17, 17, 17, 16, 16, 15, 15, 15, 15, 15, 15, 15},
+        {17, 17, 17, 17, 17, 17, 17, 17, 15, 15, 15, 15, 15, 15, 15, 15},
+        {17, 17, 17, 17, 17, 17, 17, 18, 13, 15, 15, 15, 15, 15, 15, 15},
+        {17, 17, 17, 17, 18, 18, 18, 18, 13, 13, 13, 13, 15, 15, 15, 15},
+        {17, 17, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 15, 15},
+        {18, 18, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 13, 13},
+        {18, 18, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 13, 13},
+        {18, 18, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 13, 13},
+        {18, 18, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 13, 13},
+        {19, 19, 18, 18, 18, 18, 18, 18, 13, 13, 13, 13, 13, 13, 11, 11},
+        {19, 19, 19, 19, 18, 18, 18, 18, 13, 13, 13, 13, 11, 11, 11, 11},
+        {19, 19, 19, 19, 19, 19, 19, 18, 13, 11, 11, 11, 11, 11, 11, 11},
+        {19, 19, 19, 19, 19, 19, 19, 19, 11, 11, 11, 11, 11, 11, 11, 11},
+        {19, 19, 19, 19, 19, 19, 19, 10, 10, 11, 11, 11, 11, 11, 11, 11},
+        {19, 19, 19, 19, 19, 19, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11},
+    },
+    {
+        { 1,  1,  1,  1,  1,  1,  0,  0,  0,  0,  9,  9,  9,  9,  9,  9},
+        { 1,  1,  1,  1,  1,  1,  1,  0,  0,  9,  9,  9,  9,  9,  9,  9},
+        { 1,  1,  1,  1,  1,  1,  1,  1,  9,  9,  9,  9,  9,  9,  9,  9},
+        { 1,  1,  1,  1,  1,  1,  1,  3,  8,  9,  9,  9,  9,  9,  9,  9},
+        { 1,  1,  1,  1,  3,  3,  3,  3,  8,  8,  8,  8,  9,  9,  9,  9},
+        { 1,  1,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  9,  9},
+        { 3,  3,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  8,  8},
+        { 3,  3,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  8,  8},
+        { 3,  3,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  8,  8},
+        { 3,  3,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  8,  8},
+        { 5,  5,  3,  3,  3,  3,  3,  3,  8,  8,  8,  8,  8,  8,  7,  7},
+        { 5,  5,  5,  5,  3,  3,  3,  3,  8,  8,  8,  8,  7,  7,  7,  7},
+        { 5,  5,  5,  5,  5,  5,  5,  3,  8,  7,  7,  7,  7,  7,  7,  7},
+        { 5,  5,  5,  5,  5,  5,  5,  5,  7,  7,  7,  7,  7,  7,  7,  7},
+        { 5,  5,  5,  5,  5,  5,  5,  6,  6,  7,  7,  7,  7,  7,  7,  7},
+        { 5,  5,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,  7,  7},
+    },
+};
+
 int AP_GeodesicGrid::section(const Vector3f &v, bool inclusive)
 {
-    int i = _triangle_index(v, inclusive);
+    int i = _triangle_index_lookup(v);
     if (i < 0) {
-        return -1;
+        i = _triangle_index(v, inclusive);
+        if (i < 0) {
+            return -1;
+        }
     }
 
     int j = _subtriangle_index(i, v, inclusive);
@@ -199,6 +315,28 @@ int AP_GeodesicGrid::section(const Vector3f &v, bool inclusive)
     return 4 * i + j;
 }
 
+void AP_GeodesicGrid::sections(const Vector3f *v,
+                               int *sections,
+                               uint16_t count,
+                               bool inclusive)
+{
+    /* Go through the whole batch with the lookup table first, so that the
+     * loop is short and predictable for the vectors it resolves, which are
+     * most of them. */
+    for (uint16_t k = 0; k < count; k++) {
+        sections[k] = _triangle_index_lookup(v[k]);
+    }
+
+    for (uint16_t k = 0; k < count; k++) {
+        int i = sections[k];
+        if (i < 0) {
+            i = _triangle_index(v[k], inclusive);
+        }
+        int j = i < 0 ? -1 : _subtriangle_index(i, v[k], inclusive);
+        sections[k] = j < 0 ? -1 : 4 * i + j;
+    }
+}
+
 int AP_GeodesicGrid::_neighbor_umbrella_component(int idx, int comp_idx)
 {
     if (idx < 3) {
@@ -437,6 +575,61 @@ int AP_GeodesicGrid::_triangle_index(const Vector3f &v, bool inclusive)
     return _from_neighbor_umbrella(umbrella, v, w, inclusive);
 }
 
+int AP_GeodesicGrid::_triangle_index_lookup(const Vector3f &v)
+{
+    /* Project v onto the face of the cube [-1,1]^3 it crosses, which is given
+     * by its coordinate with greatest absolute value */
+    const float ax = fabsf(v.x);
+    const float ay = fabsf(v.y);
+    const float az = fabsf(v.z);
+    int face;
+    float major, p, q;
+
+    if (ax >= ay && ax >= az) {
+        face = v.x < 0 ? 1 : 0;
+        major = ax;
+        p = v.y;
+        q = v.z;
+    } else if (ay >= az) {
+        face = v.y < 0 ? 3 : 2;
+        major = ay;
+        p = v.x;
+        q = v.z;
+    } else {
+        face = v.z < 0 ? 5 : 4;
+        major = az;
+        p = v.x;
+        q = v.y;
+    }
+
+    /* This also leaves the null vector, NaN and infinity to the full
+     * search. A NaN in one of the other coordinates fails every comparison
+     * above, so it can end up in p or q with a finite major, and must not
+     * reach the cell index */
+    if (!(major > 0) || isinf(major) || isnan(p) || isnan(q) || isinf(p) || isinf(q)) {
+        return -1;
+    }
+
+    const float scale = .5f * LOOKUP_CELLS / major;
+    const int ci = MIN((int)(p * scale + .5f * LOOKUP_CELLS), LOOKUP_CELLS - 1);
+    const int cj = MIN((int)(q * scale + .5f * LOOKUP_CELLS), LOOKUP_CELLS - 1);
+    const int i = _lookup[face][ci][cj];
+
+    /* The guess is right iff all the coefficients of v with respect to the
+     * triangle's basis are positive. Vectors close to the triangle's edges
+     * are left to _triangle_index() so that the inclusive rule is applied the
+     * same way as for any other vector. */
+    auto w = _inverses[i % 10] * v;
+    if (i > 9) {
+        w = -w;
+    }
+    if (!is_positive(w.x) || !is_positive(w.y) || !is_positive(w.z)) {
+        return -1;
+    }
+
+    return i;
+}
+
 int AP_GeodesicGrid::_subtriangle_index(const unsigned int triangle_index,
                                         const Vector3f &v,
                                         bool inclusive)
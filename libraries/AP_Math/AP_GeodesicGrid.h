@@ -125,6 +125,29 @@ public:
      */
     static int section(const Vector3f &v, bool inclusive = false);
 
+    /**
+     * Find which section is crossed by each vector of \p v.
+     *
+     * The results are the same as calling #section() for each vector, but
+     * the lookup table is tried for the whole batch before falling back to
+     * the full search for the vectors it couldn't resolve, which keeps the
+     * common path short when classifying many samples at once.
+     *
+     * @param v[in] The vectors to be verified.
+     *
+     * @param sections[out] The index of the section crossed by each vector
+     * of \p v, following the same rules as the return value of #section().
+     *
+     * @param count[in] The number of vectors in \p v.
+     *
+     * @param inclusive[in] This parameter follows the same rules defined in
+     * #section() const.
+     */
+    static void sections(const Vector3f *v,
+                         int *sections,
+                         uint16_t count,
+                         bool inclusive = false);
+
 private:
     /*
      * The following are concepts used in the description of the private
@@ -178,6 +201,27 @@ private:
      */
     static const Matrix3f _mid_inverses[10];
 
+    /**
+     * Number of cells along each side of a face of the lookup table's cube.
+     */
+    static const int LOOKUP_CELLS = 16;
+
+    /**
+     * Lookup table for a first guess of the icosahedron triangle crossed by a
+     * vector.
+     *
+     * Each face of the cube [-1,1]^3 is divided into #LOOKUP_CELLS x
+     * #LOOKUP_CELLS cells and the table holds the index of the icosahedron
+     * triangle that covers most of the cell. Faces are indexed by 2 * axis +
+     * (1 if the face is on the negative side of the axis), where axis is 0, 1
+     * or 2 for x, y and z respectively. The cells are indexed by the
+     * remaining coordinates, in the order x, y and z.
+     *
+     * A vector close to a cell's border with another triangle may not cross
+     * the triangle in the table, thus the guess must always be verified.
+     */
+    static const uint8_t _lookup[6][LOOKUP_CELLS][LOOKUP_CELLS];
+
     /**
      * The representation of the neighbor umbrellas of T_0.
      *
@@ -274,6 +318,17 @@ private:
      */
     static int _triangle_index(const Vector3f &v, bool inclusive);
 
+    /**
+     * Find which icosahedron's triangle is crossed by \p v using #_lookup.
+     *
+     * @param v[in] The vector to be verified.
+     *
+     * @return The index of the triangle. The value -1 is returned if \p v
+     * doesn't cross the interior of the triangle guessed by #_lookup, in
+     * which case #_triangle_index() must be used instead.
+     */
+    static int _triangle_index_lookup(const Vector3f &v);
+
     /**
      * Find which sub-triangle of the icosahedron's triangle pointed by \p
      * triangle_index is crossed by \p v.
@@ -98,4 +98,54 @@ static void BM_GeodesicGridSections(benchmark::State& state)
 /* Benchmark each section */
 BENCHMARK(BM_GeodesicGridSections)->DenseRange(0, 79);
 
+#define MAX_BATCH 1024
+
+/* Fill v with vectors crossing the centroids of the sections, going
+ * through them in order and wrapping around if n is greater than 80 */
+static void section_centroids(Vector3f *v, int n)
+{
+    Vector3f a, b, c;
+
+    for (int i = 0; i < n; i++) {
+        section_triangle(i % 80, a, b, c);
+        v[i] = (a + b + c) / 3.0f;
+    }
+}
+
+static void BM_GeodesicGridSectionsLoop(benchmark::State& state)
+{
+    int n = state.range_x();
+    Vector3f v[MAX_BATCH];
+    int s[MAX_BATCH];
+
+    section_centroids(v, n);
+
+    while (state.KeepRunning()) {
+        for (int i = 0; i < n; i++) {
+            s[i] = AP_GeodesicGrid::section(v[i]);
+        }
+        gbenchmark_escape(s);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_GeodesicGridSectionsBatch(benchmark::State& state)
+{
+    int n = state.range_x();
+    Vector3f v[MAX_BATCH];
+    int s[MAX_BATCH];
+
+    section_centroids(v, n);
+
+    while (state.KeepRunning()) {
+        AP_GeodesicGrid::sections(v, s, n);
+        gbenchmark_escape(s);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Compare classifying batches of vectors one by one and in a single call */
+BENCHMARK(BM_GeodesicGridSectionsLoop)->Range(8, MAX_BATCH);
+BENCHMARK(BM_GeodesicGridSectionsBatch)->Range(8, MAX_BATCH);
+
 BENCHMARK_MAIN()
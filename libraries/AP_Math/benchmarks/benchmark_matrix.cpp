@@ -2,6 +2,15 @@
 
 #include <AP_Math/AP_Math.h>
 
+/*
+  these cover the float operations that have SSE/NEON kernels when
+  built with --enable-math-simd, compare a run of each configuration
+ */
+
+static const Matrix3f m_a(Vector3f(1.0f, 2.0f, 3.0f),
+                          Vector3f(4.0f, 5.0f, 6.0f),
+                          Vector3f(7.0f, 8.0f, 9.0f));
+
 static void BM_MatrixMultiplication(benchmark::State& state)
 {
     Matrix3f m1(Vector3f(1.0f, 2.0f, 3.0f),
@@ -17,6 +26,83 @@ static void BM_MatrixMultiplication(benchmark::State& state)
     }
 }
 
+static void BM_MatrixVectorMultiplication(benchmark::State& state)
+{
+    Matrix3f m = m_a;
+    Vector3f v(0.1f, 0.2f, 0.3f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        Vector3f r = m * v;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_MatrixMulTranspose(benchmark::State& state)
+{
+    Matrix3f m = m_a;
+    Vector3f v(0.1f, 0.2f, 0.3f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        Vector3f r = m.mul_transpose(v);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_MatrixRotateNormalize(benchmark::State& state)
+{
+    Matrix3f m;
+    m.from_euler(0.1f, 0.2f, 0.3f);
+    const Vector3f g(0.001f, -0.002f, 0.003f);
+
+    while (state.KeepRunning()) {
+        m.rotate(g);
+        m.normalize();
+        gbenchmark_escape(&m);
+    }
+}
+
+static void BM_VectorCrossProduct(benchmark::State& state)
+{
+    Vector3f v1(1.0f, 2.0f, 3.0f);
+    Vector3f v2(4.0f, 5.0f, 6.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v1);
+        Vector3f v3 = v1 % v2;
+        gbenchmark_escape(&v3);
+    }
+}
+
+static void BM_QuaternionMultiplication(benchmark::State& state)
+{
+    Quaternion q1(0.7f, 0.1f, 0.5f, 0.2f);
+    Quaternion q2(0.9f, -0.3f, 0.1f, 0.2f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&q1);
+        Quaternion q3 = q1 * q2;
+        gbenchmark_escape(&q3);
+    }
+}
+
+static void BM_QuaternionNormalize(benchmark::State& state)
+{
+    Quaternion q(0.7f, 0.1f, 0.5f, 0.2f);
+
+    while (state.KeepRunning()) {
+        q.normalize();
+        gbenchmark_escape(&q);
+    }
+}
+
 BENCHMARK(BM_MatrixMultiplication);
+BENCHMARK(BM_MatrixVectorMultiplication);
+BENCHMARK(BM_MatrixMulTranspose);
+BENCHMARK(BM_MatrixRotateNormalize);
+BENCHMARK(BM_VectorCrossProduct);
+BENCHMARK(BM_QuaternionMultiplication);
+BENCHMARK(BM_QuaternionNormalize);
 
 BENCHMARK_MAIN()
@@ -0,0 +1,108 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  compare the linear polygon fence checks with AP_PolygonIndex on a
+  fence of state.range(0) points, with the vehicle moving around inside
+ */
+
+static Vector2f fence[AP_POLYGON_INDEX_MAX_EDGES];
+static Vector2f positions[64];
+
+static void setup_fence(uint16_t n)
+{
+    for (uint16_t i = 0; i < n - 1; i++) {
+        const float angle = i * M_2PI / (n - 1);
+        const float radius = 40000.0f + ((i % 2) ? 15000.0f : 0.0f) + 5000.0f * sinf(7 * angle);
+        fence[i] = Vector2f(radius * cosf(angle), 0.5f * radius * sinf(angle));
+    }
+    fence[n - 1] = fence[0];
+    for (uint8_t i = 0; i < ARRAY_SIZE(positions); i++) {
+        const float angle = i * M_2PI / ARRAY_SIZE(positions);
+        positions[i] = Vector2f(35000.0f * cosf(angle), 15000.0f * sinf(angle));
+    }
+}
+
+static void BM_PolygonOutside(benchmark::State& state)
+{
+    const uint16_t n = state.range(0);
+    setup_fence(n);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        bool outside = Polygon_outside(positions[i], fence, n);
+        gbenchmark_escape(&outside);
+        i = (i + 1) % ARRAY_SIZE(positions);
+    }
+}
+
+static void BM_PolygonIndexOutside(benchmark::State& state)
+{
+    const uint16_t n = state.range(0);
+    setup_fence(n);
+    AP_PolygonIndex index;
+    index.build(fence, n);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        bool outside = index.outside(positions[i]);
+        gbenchmark_escape(&outside);
+        i = (i + 1) % ARRAY_SIZE(positions);
+    }
+}
+
+// the edges AC_Avoid checks for a 20m stopping distance
+static void BM_PolygonEdgesNearLinear(benchmark::State& state)
+{
+    const uint16_t n = state.range(0);
+    setup_fence(n);
+    const Vector2f range(2000.0f, 2000.0f);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        const Vector2f min = positions[i] - range;
+        const Vector2f max = positions[i] + range;
+        uint16_t count = 0;
+        for (uint16_t e = 0, j = n - 1; e < n; j = e++) {
+            if (MIN(fence[e].x, fence[j].x) <= max.x && MAX(fence[e].x, fence[j].x) >= min.x &&
+                MIN(fence[e].y, fence[j].y) <= max.y && MAX(fence[e].y, fence[j].y) >= min.y) {
+                count++;
+            }
+        }
+        gbenchmark_escape(&count);
+        i = (i + 1) % ARRAY_SIZE(positions);
+    }
+}
+
+static void BM_PolygonIndexEdgesNear(benchmark::State& state)
+{
+    const uint16_t n = state.range(0);
+    setup_fence(n);
+    AP_PolygonIndex index;
+    index.build(fence, n);
+    const Vector2f range(2000.0f, 2000.0f);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        AP_PolygonIndex::EdgeSet edges;
+        uint16_t count = index.edges_in_box(positions[i] - range, positions[i] + range, edges);
+        gbenchmark_escape(&count);
+        i = (i + 1) % ARRAY_SIZE(positions);
+    }
+}
+
+static void BM_PolygonIndexBuild(benchmark::State& state)
+{
+    const uint16_t n = state.range(0);
+    setup_fence(n);
+    AP_PolygonIndex index;
+    while (state.KeepRunning()) {
+        bool ok = index.build(fence, n);
+        gbenchmark_escape(&ok);
+    }
+}
+
+BENCHMARK(BM_PolygonOutside)->Arg(16)->Arg(64)->Arg(255);
+BENCHMARK(BM_PolygonIndexOutside)->Arg(16)->Arg(64)->Arg(255);
+BENCHMARK(BM_PolygonEdgesNearLinear)->Arg(16)->Arg(64)->Arg(255);
+BENCHMARK(BM_PolygonIndexEdgesNear)->Arg(16)->Arg(64)->Arg(255);
+BENCHMARK(BM_PolygonIndexBuild)->Arg(16)->Arg(64)->Arg(255);
+
+BENCHMARK_MAIN()
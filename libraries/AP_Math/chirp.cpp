@@ -0,0 +1,61 @@
+/*
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "AP_Math.h"
+#include "chirp.h"
+
+// setup the sweep, times in seconds and frequencies in Hz
+void Chirp::init(float time_record, float frequency_start_hz, float frequency_stop_hz,
+                 float time_fade_in, float time_fade_out)
+{
+    _record = MAX(time_record, 0.1f);
+    _wmin = M_2PI * MAX(frequency_start_hz, 0.01f);
+    const float wmax = M_2PI * MAX(frequency_stop_hz, frequency_start_hz);
+    _fade_in = constrain_float(time_fade_in, 0.0f, 0.5f * _record);
+    _fade_out = constrain_float(time_fade_out, 0.0f, 0.5f * _record);
+
+    // w(t) = wmin * exp(rate * t) reaches wmax at the end of the record
+    _rate = logf(wmax / _wmin) / _record;
+
+    _frequency_hz = _wmin / M_2PI;
+    _completed = false;
+}
+
+// value of the sweep at time seconds since the start of the record
+float Chirp::update(float time, float magnitude)
+{
+    if (time < 0.0f || time > _record) {
+        _completed = time > _record;
+        return 0.0f;
+    }
+
+    float window = 1.0f;
+    if (time < _fade_in) {
+        window = 0.5f - 0.5f * cosf(M_PI * time / _fade_in);
+    } else if (time > _record - _fade_out) {
+        window = 0.5f - 0.5f * cosf(M_PI * (_record - time) / _fade_out);
+    }
+
+    // phase is the integral of the frequency
+    const float growth = expf(_rate * time);
+    _frequency_hz = _wmin * growth / M_2PI;
+    float phase;
+    if (is_positive(_rate)) {
+        phase = _wmin / _rate * (growth - 1.0f);
+    } else {
+        phase = _wmin * time;
+    }
+
+    return magnitude * window * sinf(phase);
+}
@@ -0,0 +1,49 @@
+/*
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+/*
+  logarithmic frequency sweep for system identification.
+
+  The frequency rises exponentially from the start to the stop
+  frequency over the record, so that each octave gets the same time.
+  The amplitude fades in and out with a cosine window to avoid a step
+  at each end of the record.
+ */
+class Chirp {
+public:
+    // setup the sweep, times in seconds and frequencies in Hz
+    void init(float time_record, float frequency_start_hz, float frequency_stop_hz,
+              float time_fade_in, float time_fade_out);
+
+    // value of the sweep at time seconds since the start of the record
+    float update(float time, float magnitude);
+
+    // frequency of the sweep at the last update in Hz
+    float get_frequency_hz() const { return _frequency_hz; }
+
+    // true once the record is complete, the output is then zero
+    bool completed() const { return _completed; }
+
+private:
+    float _record;
+    float _wmin;            // start frequency, rad/s
+    float _fade_in;
+    float _fade_out;
+    float _rate;            // exponential sweep rate, 1/s
+
+    float _frequency_hz;
+    bool _completed;
+};
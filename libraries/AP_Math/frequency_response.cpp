@@ -0,0 +1,180 @@
+/*
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "AP_Math.h"
+#include "frequency_response.h"
+
+// setup num_bins log spaced bins from f_min_hz to f_max_hz and reset
+void FrequencyResponse::init(float f_min_hz, float f_max_hz, uint8_t num_bins)
+{
+    _num_bins = constrain_int16(num_bins, 2, MAX_BINS);
+    f_min_hz = MAX(f_min_hz, 0.01f);
+    f_max_hz = MAX(f_max_hz, f_min_hz);
+    const float ratio = powf(f_max_hz / f_min_hz, 1.0f / (_num_bins - 1));
+    float f = f_min_hz;
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        _bins[i].omega = M_2PI * f;
+        f *= ratio;
+    }
+    reset();
+}
+
+// clear the accumulated transforms
+void FrequencyResponse::reset()
+{
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        bin_state &b = _bins[i];
+        b.ph_re = 1.0f;
+        b.ph_im = 0.0f;
+        b.in_re = b.in_im = 0.0f;
+        b.out_re = b.out_im = 0.0f;
+    }
+    // force the rotations to be calculated on the first update
+    _rot_dt = -1.0f;
+}
+
+// add a sample of the input and output, dt is the time since the last sample
+void FrequencyResponse::update(float input, float output, float dt)
+{
+    if (!is_positive(dt)) {
+        return;
+    }
+
+    // the main loop period is fixed, so the rotations rarely need recalculating
+    if (!is_equal(dt, _rot_dt)) {
+        _rot_dt = dt;
+        for (uint8_t i = 0; i < _num_bins; i++) {
+            _bins[i].rot_re = cosf(_bins[i].omega * dt);
+            _bins[i].rot_im = -sinf(_bins[i].omega * dt);
+        }
+    }
+
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        bin_state &b = _bins[i];
+        b.in_re += input * b.ph_re * dt;
+        b.in_im += input * b.ph_im * dt;
+        b.out_re += output * b.ph_re * dt;
+        b.out_im += output * b.ph_im * dt;
+
+        // advance the phasor, pulling its magnitude back to one so
+        // rounding errors do not accumulate over a long record
+        const float re = b.ph_re * b.rot_re - b.ph_im * b.rot_im;
+        const float im = b.ph_re * b.rot_im + b.ph_im * b.rot_re;
+        const float scale = 1.5f - 0.5f * (re * re + im * im);
+        b.ph_re = re * scale;
+        b.ph_im = im * scale;
+    }
+}
+
+float FrequencyResponse::get_frequency_hz(uint8_t bin) const
+{
+    if (bin >= _num_bins) {
+        return 0.0f;
+    }
+    return _bins[bin].omega / M_2PI;
+}
+
+// response of a bin as a complex number, false if not valid
+bool FrequencyResponse::get_response_complex(uint8_t bin, float &re, float &im) const
+{
+    if (bin >= _num_bins) {
+        return false;
+    }
+    float max_input_sq = 0.0f;
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        max_input_sq = MAX(max_input_sq, sq(_bins[i].in_re, _bins[i].in_im));
+    }
+    const bin_state &b = _bins[bin];
+    const float input_sq = sq(b.in_re, b.in_im);
+    if (!is_positive(input_sq) || input_sq < sq(VALID_INPUT_RATIO) * max_input_sq) {
+        return false;
+    }
+
+    // out / in
+    re = (b.out_re * b.in_re + b.out_im * b.in_im) / input_sq;
+    im = (b.out_im * b.in_re - b.out_re * b.in_im) / input_sq;
+    return true;
+}
+
+// gain and phase in radians of the output relative to the input at a bin,
+// returns false if the input had too little energy at that frequency
+bool FrequencyResponse::get_response(uint8_t bin, float &gain, float &phase) const
+{
+    float re, im;
+    if (!get_response_complex(bin, re, im)) {
+        return false;
+    }
+    gain = norm(re, im);
+    phase = atan2f(im, re);
+    return true;
+}
+
+// treating the response as an open loop transfer function, find the
+// frequency where the gain falls through one and the phase margin there
+bool FrequencyResponse::get_crossover(float &frequency_hz, float &phase_margin_deg) const
+{
+    float prev_gain = 0.0f, prev_phase = 0.0f;
+    int16_t prev = -1;
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        float gain, phase;
+        if (!get_response(i, gain, phase) || !is_positive(gain)) {
+            continue;
+        }
+        if (prev >= 0 && prev_gain >= 1.0f && gain < 1.0f) {
+            // interpolate the log of the gain against the log of the frequency
+            const float t = logf(prev_gain) / (logf(prev_gain) - logf(gain));
+            const float phase_cross = prev_phase + t * wrap_PI(phase - prev_phase);
+            frequency_hz = get_frequency_hz(prev) * powf(get_frequency_hz(i) / get_frequency_hz(prev), t);
+            phase_margin_deg = degrees(wrap_PI(phase_cross + M_PI));
+            return true;
+        }
+        prev = i;
+        prev_gain = gain;
+        prev_phase = phase;
+    }
+    return false;
+}
+
+// treating the response as an open loop transfer function, find the
+// frequency where the gain of the closed loop falls below -3dB
+bool FrequencyResponse::get_closed_loop_bandwidth(float &frequency_hz) const
+{
+    const float gain_3db = sqrtf(0.5f);
+    float prev_gain = 0.0f;
+    int16_t prev = -1;
+    for (uint8_t i = 0; i < _num_bins; i++) {
+        float re, im;
+        if (!get_response_complex(i, re, im)) {
+            continue;
+        }
+        // L / (1 + L)
+        const float den = sq(1.0f + re, im);
+        if (!is_positive(den)) {
+            continue;
+        }
+        const float gain = sqrtf(sq(re, im) / den);
+        if (prev < 0 && gain < gain_3db) {
+            // the loop does not track at the lowest frequency measured
+            return false;
+        }
+        if (prev >= 0 && prev_gain >= gain_3db && gain < gain_3db) {
+            const float t = (prev_gain - gain_3db) / (prev_gain - gain);
+            frequency_hz = get_frequency_hz(prev) * powf(get_frequency_hz(i) / get_frequency_hz(prev), t);
+            return true;
+        }
+        prev = i;
+        prev_gain = gain;
+    }
+    return false;
+}
@@ -0,0 +1,77 @@
+/*
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <stdint.h>
+
+/*
+  streaming estimate of the frequency response from an input to an
+  output signal at a set of log spaced frequencies.
+
+  Each bin is a single frequency DFT of the input and of the output,
+  accumulated one sample at a time with a rotating phasor, so the cost
+  per sample is a few multiplies per bin and no history is stored. The
+  response at a bin is the ratio of the output and input transforms,
+  which is only meaningful where the input, such as a frequency sweep,
+  has energy.
+ */
+class FrequencyResponse {
+public:
+    static const uint8_t MAX_BINS = 20;
+
+    FrequencyResponse() : _num_bins(0) {}
+
+    // setup num_bins log spaced bins from f_min_hz to f_max_hz and reset
+    void init(float f_min_hz, float f_max_hz, uint8_t num_bins);
+
+    // clear the accumulated transforms
+    void reset();
+
+    // add a sample of the input and output, dt is the time since the last sample
+    void update(float input, float output, float dt);
+
+    uint8_t get_num_bins() const { return _num_bins; }
+    float get_frequency_hz(uint8_t bin) const;
+
+    // gain and phase in radians of the output relative to the input at a bin,
+    // returns false if the input had too little energy at that frequency
+    bool get_response(uint8_t bin, float &gain, float &phase) const;
+
+    // treating the response as an open loop transfer function, find the
+    // frequency where the gain falls through one and the phase margin there
+    bool get_crossover(float &frequency_hz, float &phase_margin_deg) const;
+
+    // treating the response as an open loop transfer function, find the
+    // frequency where the gain of the closed loop falls below -3dB
+    bool get_closed_loop_bandwidth(float &frequency_hz) const;
+
+private:
+    // the input transform of a valid bin must be at least this fraction of the largest
+    static constexpr float VALID_INPUT_RATIO = 0.05f;
+
+    // response of a bin as a complex number, false if not valid
+    bool get_response_complex(uint8_t bin, float &re, float &im) const;
+
+    struct bin_state {
+        float omega;            // frequency, rad/s
+        float rot_re, rot_im;   // phasor rotation per sample of _rot_dt
+        float ph_re, ph_im;     // phasor, exp(-j omega t)
+        float in_re, in_im;     // input transform
+        float out_re, out_im;   // output transform
+    } _bins[MAX_BINS];
+
+    uint8_t _num_bins;
+    float _rot_dt;              // dt the phasor rotations were calculated for
+};
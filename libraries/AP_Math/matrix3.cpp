@@ -193,6 +193,66 @@ Matrix3<T> Matrix3<T>::transposed(void) const
                       Vector3<T>(a.z, b.z, c.z));
 }
 
+#if AP_MATH_SIMD
+template <>
+void Matrix3<float>::rotate(const Vector3<float> &g)
+{
+    const simd_f4 vg = simd_load3(&g.x);
+    const simd_f4 va = simd_load3(&a.x);
+    const simd_f4 vb = simd_load3(&b.x);
+    const simd_f4 vc = simd_load3(&c.x);
+    simd_store3(&a.x, simd_add(va, simd_cross3(va, vg)));
+    simd_store3(&b.x, simd_add(vb, simd_cross3(vb, vg)));
+    simd_store3(&c.x, simd_add(vc, simd_cross3(vc, vg)));
+}
+
+template <>
+void Matrix3<float>::normalize(void)
+{
+    const simd_f4 va = simd_load3(&a.x);
+    const simd_f4 vb = simd_load3(&b.x);
+    const simd_f4 half_error = simd_set1(0.5f * simd_hsum(simd_mul(va, vb)));
+    const simd_f4 t0 = simd_sub(va, simd_mul(vb, half_error));
+    const simd_f4 t1 = simd_sub(vb, simd_mul(va, half_error));
+    const simd_f4 t2 = simd_cross3(t0, t1);
+    simd_store3(&a.x, simd_mul(t0, simd_set1(1.0f / simd_length3(t0))));
+    simd_store3(&b.x, simd_mul(t1, simd_set1(1.0f / simd_length3(t1))));
+    simd_store3(&c.x, simd_mul(t2, simd_set1(1.0f / simd_length3(t2))));
+}
+
+template <>
+Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const
+{
+    simd_f4 r = simd_mul(simd_load3(&a.x), simd_set1(v.x));
+    r = simd_madd(r, simd_load3(&b.x), simd_set1(v.y));
+    r = simd_madd(r, simd_load3(&c.x), simd_set1(v.z));
+    Vector3<float> ret;
+    simd_store3(&ret.x, r);
+    return ret;
+}
+
+// each row of the product is a linear combination of the rows of m
+static inline simd_f4 mul_row(const Vector3<float> &r, simd_f4 ma, simd_f4 mb, simd_f4 mc)
+{
+    simd_f4 ret = simd_mul(ma, simd_set1(r.x));
+    ret = simd_madd(ret, mb, simd_set1(r.y));
+    return simd_madd(ret, mc, simd_set1(r.z));
+}
+
+template <>
+Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const
+{
+    const simd_f4 ma = simd_load3(&m.a.x);
+    const simd_f4 mb = simd_load3(&m.b.x);
+    const simd_f4 mc = simd_load3(&m.c.x);
+    Matrix3<float> temp;
+    simd_store3(&temp.a.x, mul_row(a, ma, mb, mc));
+    simd_store3(&temp.b.x, mul_row(b, ma, mb, mc));
+    simd_store3(&temp.c.x, mul_row(c, ma, mb, mc));
+    return temp;
+}
+#endif // AP_MATH_SIMD
+
 template <typename T>
 T Matrix3<T>::det() const
 {
@@ -269,8 +329,10 @@ void Matrix3<T>::from_axis_angle(const Vector3<T> &v, float theta)
 
 // only define for float
 template void Matrix3<float>::zero(void);
+#if !AP_MATH_SIMD
 template void Matrix3<float>::rotate(const Vector3<float> &g);
 template void Matrix3<float>::normalize(void);
+#endif
 template void Matrix3<float>::from_euler(float roll, float pitch, float yaw);
 template void Matrix3<float>::to_euler(float *roll, float *pitch, float *yaw) const;
 template void Matrix3<float>::from_rotation(enum Rotation rotation);
@@ -278,8 +340,10 @@ template void Matrix3<float>::from_euler312(float roll, float pitch, float yaw);
 template void Matrix3<float>::from_axis_angle(const Vector3<float> &v, float theta);
 template Vector3<float> Matrix3<float>::to_euler312(void) const;
 template Vector3<float> Matrix3<float>::operator *(const Vector3<float> &v) const;
+#if !AP_MATH_SIMD
 template Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const;
 template Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const;
+#endif
 template Matrix3<float> Matrix3<float>::transposed(void) const;
 template float Matrix3<float>::det() const;
 template bool Matrix3<float>::inverse(Matrix3<float>& inv) const;
@@ -38,6 +38,7 @@
 #pragma once
 
 #include "vector3.h"
+#include "simd.h"
 
 // 3x3 matrix with elements of type T
 template <typename T>
@@ -263,6 +264,14 @@ public:
     void        normalize(void);
 };
 
+#if AP_MATH_SIMD
+// SSE/NEON versions of the float operations, see simd.h
+template <> void Matrix3<float>::rotate(const Vector3<float> &g);
+template <> void Matrix3<float>::normalize(void);
+template <> Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const;
+template <> Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const;
+#endif
+
 typedef Matrix3<int16_t>                Matrix3i;
 typedef Matrix3<uint16_t>               Matrix3ui;
 typedef Matrix3<int32_t>                Matrix3l;
@@ -24,6 +24,43 @@
  */
 
 
+/*
+ *  returns true if a ray from P in the +x direction crosses the edge
+ *  from Vj to Vi. Edges that do not straddle P.y are never crossed.
+ */
+template <typename T>
+static inline bool Polygon_edge_crossed(const Vector2<T> &P, const Vector2<T> &Vi, const Vector2<T> &Vj)
+{
+    if ((Vi.y > P.y) == (Vj.y > P.y)) {
+        return false;
+    }
+    const int32_t dx1 = P.x - Vi.x;
+    const int32_t dx2 = Vj.x - Vi.x;
+    const int32_t dy1 = P.y - Vi.y;
+    const int32_t dy2 = Vj.y - Vi.y;
+    const int8_t dx1s = (dx1 < 0) ? -1 : 1;
+    const int8_t dx2s = (dx2 < 0) ? -1 : 1;
+    const int8_t dy1s = (dy1 < 0) ? -1 : 1;
+    const int8_t dy2s = (dy2 < 0) ? -1 : 1;
+    const int8_t m1 = dx1s * dy2s;
+    const int8_t m2 = dx2s * dy1s;
+    // we avoid the 64 bit multiplies if we can based on sign checks.
+    if (dy2 < 0) {
+        if (m1 > m2) {
+            return true;
+        } else if (m1 < m2) {
+            return false;
+        }
+        return dx1 * (int64_t)dy2 > dx2 * (int64_t)dy1;
+    }
+    if (m1 < m2) {
+        return true;
+    } else if (m1 > m2) {
+        return false;
+    }
+    return dx1 * (int64_t)dy2 < dx2 * (int64_t)dy1;
+}
+
 /*
  *  Polygon_outside(): test for a point in a polygon
  *     Input:   P = a point,
@@ -40,36 +77,8 @@ bool Polygon_outside(const Vector2<T> &P, const Vector2<T> *V, unsigned n)
     unsigned i, j;
     bool outside = true;
     for (i = 0, j = n-1; i < n; j = i++) {
-        if ((V[i].y > P.y) == (V[j].y > P.y)) {
-            continue;
-        }
-        const int32_t dx1 = P.x - V[i].x;
-        const int32_t dx2 = V[j].x - V[i].x;
-        const int32_t dy1 = P.y - V[i].y;
-        const int32_t dy2 = V[j].y - V[i].y;
-        const int8_t dx1s = (dx1 < 0) ? -1 : 1;
-        const int8_t dx2s = (dx2 < 0) ? -1 : 1;
-        const int8_t dy1s = (dy1 < 0) ? -1 : 1;
-        const int8_t dy2s = (dy2 < 0) ? -1 : 1;
-        const int8_t m1 = dx1s * dy2s;
-        const int8_t m2 = dx2s * dy1s;
-        // we avoid the 64 bit multiplies if we can based on sign checks.
-        if (dy2 < 0) {
-            if (m1 > m2) {
-                outside = !outside;
-            } else if (m1 < m2) {
-                continue;
-            } else if ( dx1 * (int64_t)dy2 > dx2 * (int64_t)dy1 ) {
-                outside = !outside;
-            }
-        } else {
-            if (m1 < m2) {
-                outside = !outside;
-            } else if (m1 > m2) {
-                continue;
-            } else if ( dx1 * (int64_t)dy2 < dx2 * (int64_t)dy1 ) {
-                outside = !outside;
-            }
+        if (Polygon_edge_crossed(P, V[i], V[j])) {
+            outside = !outside;
         }
     }
     return outside;
@@ -93,3 +102,174 @@ template bool Polygon_outside<int32_t>(const Vector2l &P, const Vector2l *V, uns
 template bool Polygon_complete<int32_t>(const Vector2l *V, unsigned n);
 template bool Polygon_outside<float>(const Vector2f &P, const Vector2f *V, unsigned n);
 template bool Polygon_complete<float>(const Vector2f *V, unsigned n);
+
+AP_PolygonIndex::~AP_PolygonIndex()
+{
+    clear();
+}
+
+void AP_PolygonIndex::clear()
+{
+    delete[] _cell_start;
+    delete[] _refs;
+    _cell_start = nullptr;
+    _refs = nullptr;
+    _num_refs = 0;
+    _points = nullptr;
+    _num_points = 0;
+}
+
+// grid column of an x coordinate, clamped to the grid
+uint8_t AP_PolygonIndex::cell_x(float x) const
+{
+    const float c = (x - _min.x) * _cell_scale.x;
+    if (!(c > 0.0f)) {
+        return 0;
+    }
+    return c >= _grid_size ? _grid_size - 1 : (uint8_t)c;
+}
+
+// grid row of a y coordinate, clamped to the grid
+uint8_t AP_PolygonIndex::cell_y(float y) const
+{
+    const float c = (y - _min.y) * _cell_scale.y;
+    if (!(c > 0.0f)) {
+        return 0;
+    }
+    return c >= _grid_size ? _grid_size - 1 : (uint8_t)c;
+}
+
+/*
+  build the grid. The grid has roughly one cell per edge, so a typical
+  edge overlaps only a few cells and a query visits only a few edges.
+  After the cells, each grid row also gets a list of the edges
+  overlapping it in y, which is all the point in polygon test needs
+ */
+bool AP_PolygonIndex::build(const Vector2f *V, uint16_t n)
+{
+    clear();
+    if (V == nullptr || n < 3 || n > AP_POLYGON_INDEX_MAX_EDGES) {
+        return false;
+    }
+
+    _min = _max = V[0];
+    for (uint16_t i = 1; i < n; i++) {
+        _min.x = MIN(_min.x, V[i].x);
+        _min.y = MIN(_min.y, V[i].y);
+        _max.x = MAX(_max.x, V[i].x);
+        _max.y = MAX(_max.y, V[i].y);
+    }
+
+    _grid_size = 1;
+    while (_grid_size < AP_POLYGON_INDEX_MAX_GRID && _grid_size * _grid_size < n) {
+        _grid_size++;
+    }
+    const Vector2f size = _max - _min;
+    _cell_scale.x = is_positive(size.x) ? _grid_size / size.x : 0.0f;
+    _cell_scale.y = is_positive(size.y) ? _grid_size / size.y : 0.0f;
+
+    const uint16_t num_lists = _grid_size * (_grid_size + 1);
+    _cell_start = new uint16_t[num_lists + 1];
+    if (_cell_start == nullptr) {
+        return false;
+    }
+
+    // count the edges in each list, then convert the counts to end
+    // offsets which are decremented as the references are filled in,
+    // leaving the start offset of each list
+    memset(_cell_start, 0, (num_lists + 1) * sizeof(_cell_start[0]));
+    const uint16_t row_lists = _grid_size * _grid_size;
+    uint32_t total = 0;
+    for (uint16_t i = 0, j = n-1; i < n; j = i++) {
+        const uint8_t x0 = cell_x(MIN(V[i].x, V[j].x)), x1 = cell_x(MAX(V[i].x, V[j].x));
+        const uint8_t y0 = cell_y(MIN(V[i].y, V[j].y)), y1 = cell_y(MAX(V[i].y, V[j].y));
+        for (uint8_t y = y0; y <= y1; y++) {
+            for (uint8_t x = x0; x <= x1; x++) {
+                _cell_start[y * _grid_size + x]++;
+            }
+            _cell_start[row_lists + y]++;
+        }
+        total += (x1 - x0 + 2) * (y1 - y0 + 1);
+    }
+    if (total > UINT16_MAX) {
+        clear();
+        return false;
+    }
+    for (uint16_t c = 1; c < num_lists; c++) {
+        _cell_start[c] += _cell_start[c-1];
+    }
+    _cell_start[num_lists] = total;
+
+    _refs = new uint8_t[total];
+    if (_refs == nullptr) {
+        clear();
+        return false;
+    }
+    _num_refs = total;
+
+    // fill each list from the back so the references stay in edge order
+    for (uint16_t i = n; i-- > 0; ) {
+        const uint16_t j = (i == 0) ? n - 1 : i - 1;
+        const uint8_t x0 = cell_x(MIN(V[i].x, V[j].x)), x1 = cell_x(MAX(V[i].x, V[j].x));
+        const uint8_t y0 = cell_y(MIN(V[i].y, V[j].y)), y1 = cell_y(MAX(V[i].y, V[j].y));
+        for (uint8_t y = y0; y <= y1; y++) {
+            for (uint8_t x = x0; x <= x1; x++) {
+                _refs[--_cell_start[y * _grid_size + x]] = i;
+            }
+            _refs[--_cell_start[row_lists + y]] = i;
+        }
+    }
+
+    _points = V;
+    _num_points = n;
+    return true;
+}
+
+/*
+  point in polygon test using only the edges overlapping the grid row
+  of P. Any edge straddling P.y is in that row
+ */
+bool AP_PolygonIndex::outside(const Vector2f &P) const
+{
+    // no edge can straddle P.y outside the bounding box
+    if (!valid() || P.y < _min.y || P.y > _max.y) {
+        return true;
+    }
+
+    bool outside = true;
+    const uint16_t row = _grid_size * _grid_size + cell_y(P.y);
+    for (uint16_t r = _cell_start[row]; r < _cell_start[row+1]; r++) {
+        const uint16_t i = _refs[r];
+        const uint16_t j = (i == 0) ? _num_points - 1 : i - 1;
+        if (Polygon_edge_crossed(P, _points[i], _points[j])) {
+            outside = !outside;
+        }
+    }
+    return outside;
+}
+
+uint16_t AP_PolygonIndex::edges_in_box(const Vector2f &min, const Vector2f &max, EdgeSet &edges) const
+{
+    memset(&edges, 0, sizeof(edges));
+    if (!valid() || min.x > _max.x || min.y > _max.y || max.x < _min.x || max.y < _min.y) {
+        return 0;
+    }
+
+    uint16_t count = 0;
+    const uint8_t x0 = cell_x(min.x), x1 = cell_x(max.x);
+    const uint8_t y0 = cell_y(min.y), y1 = cell_y(max.y);
+    for (uint8_t y = y0; y <= y1; y++) {
+        for (uint8_t x = x0; x <= x1; x++) {
+            const uint16_t c = y * _grid_size + x;
+            for (uint16_t r = _cell_start[c]; r < _cell_start[c+1]; r++) {
+                const uint8_t e = _refs[r];
+                const uint32_t mask = 1U << (e & 31);
+                if ((edges.bits[e >> 5] & mask) == 0) {
+                    edges.bits[e >> 5] |= mask;
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
@@ -24,3 +24,69 @@ bool        Polygon_outside(const Vector2<T> &P, const Vector2<T> *V, unsigned n
 template <typename T>
 bool        Polygon_complete(const Vector2<T> *V, unsigned n);
 
+
+/*
+  uniform grid over the edges of a closed polygon, used to avoid testing
+  every edge of large fences on each call.
+
+  Edge i runs from V[i-1] to V[i], with edge 0 running from V[n-1] to
+  V[0], which is the same ordering as Polygon_outside(). Each grid cell
+  lists the edges whose bounding box overlaps it. Polygons with more than
+  AP_POLYGON_INDEX_MAX_EDGES points are not indexed and callers should
+  fall back to the linear functions.
+ */
+#define AP_POLYGON_INDEX_MAX_EDGES  256
+#define AP_POLYGON_INDEX_MAX_GRID   16
+
+class AP_PolygonIndex {
+public:
+    AP_PolygonIndex() {}
+    ~AP_PolygonIndex();
+
+    /* Do not allow copies */
+    AP_PolygonIndex(const AP_PolygonIndex &other) = delete;
+    AP_PolygonIndex &operator=(const AP_PolygonIndex&) = delete;
+
+    // set of edges, bit i is set for edge i
+    struct EdgeSet {
+        uint32_t bits[AP_POLYGON_INDEX_MAX_EDGES / 32];
+    };
+
+    // build the index over V[0..n-1]. The points are referenced, not
+    // copied, and must not change until the index is built again or
+    // cleared. Returns false if the polygon can not be indexed
+    bool build(const Vector2f *V, uint16_t n);
+
+    // forget the polygon, valid() will return false
+    void clear();
+
+    // true if the index holds a polygon
+    bool valid() const { return _points != nullptr; }
+
+    // same result as Polygon_outside(P, V, n) for the indexed polygon
+    bool outside(const Vector2f &P) const;
+
+    // set the edges whose bounding box may overlap the rectangle
+    // [min, max] in edges. Returns the number of edges found
+    uint16_t edges_in_box(const Vector2f &min, const Vector2f &max, EdgeSet &edges) const;
+
+private:
+    uint8_t cell_x(float x) const;
+    uint8_t cell_y(float y) const;
+
+    const Vector2f *_points = nullptr;
+    uint16_t _num_points = 0;
+
+    // bounding box of the polygon and inverse cell dimensions
+    Vector2f _min;
+    Vector2f _max;
+    Vector2f _cell_scale;
+    uint8_t _grid_size = 0;
+
+    // edge references of list c are _refs[_cell_start[c]] up to
+    // _refs[_cell_start[c+1]]. The grid cells are stored row (y) major
+    // and are followed by one list per row
+    uint16_t *_cell_start = nullptr;
+    uint8_t *_refs = nullptr;
+    uint16_t _num_refs = 0;
+};
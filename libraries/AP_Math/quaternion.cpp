@@ -296,6 +296,13 @@ Quaternion Quaternion::inverse(void) const
 
 void Quaternion::normalize(void)
 {
+#if AP_MATH_SIMD
+    const simd_f4 q = simd_load4(&q1);
+    const float quatMag = sqrtf(simd_hsum(simd_mul(q, q)));
+    if (!is_zero(quatMag)) {
+        simd_store4(&q1, simd_mul(q, simd_set1(1.0f/quatMag)));
+    }
+#else
     float quatMag = length();
     if (!is_zero(quatMag)) {
         float quatMagInv = 1.0f/quatMag;
@@ -304,11 +311,30 @@ void Quaternion::normalize(void)
         q3 *= quatMagInv;
         q4 *= quatMagInv;
     }
+#endif
+}
+
+#if AP_MATH_SIMD
+// Hamilton product of q and v, both held as (w,x,y,z)
+static inline simd_f4 quaternion_multiply(const Quaternion &q, const Quaternion &v)
+{
+    static const float sign_x[4] = { -1.0f,  1.0f, -1.0f,  1.0f };
+    static const float sign_y[4] = { -1.0f,  1.0f,  1.0f, -1.0f };
+    static const float sign_z[4] = { -1.0f, -1.0f,  1.0f,  1.0f };
+    const simd_f4 v4 = simd_load4(&v.q1);
+    simd_f4 ret = simd_mul(v4, simd_set1(q.q1));
+    ret = simd_madd(ret, simd_mul(simd_swap_pairs(v4), simd_load4(sign_x)), simd_set1(q.q2));
+    ret = simd_madd(ret, simd_mul(simd_swap_halves(v4), simd_load4(sign_y)), simd_set1(q.q3));
+    return simd_madd(ret, simd_mul(simd_reverse(v4), simd_load4(sign_z)), simd_set1(q.q4));
 }
+#endif
 
 Quaternion Quaternion::operator*(const Quaternion &v) const
 {
     Quaternion ret;
+#if AP_MATH_SIMD
+    simd_store4(&ret.q1, quaternion_multiply(*this, v));
+#else
     const float &w1 = q1;
     const float &x1 = q2;
     const float &y1 = q3;
@@ -323,12 +349,16 @@ Quaternion Quaternion::operator*(const Quaternion &v) const
     ret.q2 = w1*x2 + x1*w2 + y1*z2 - z1*y2;
     ret.q3 = w1*y2 - x1*z2 + y1*w2 + z1*x2;
     ret.q4 = w1*z2 + x1*y2 - y1*x2 + z1*w2;
+#endif
 
     return ret;
 }
 
 Quaternion &Quaternion::operator*=(const Quaternion &v)
 {
+#if AP_MATH_SIMD
+    simd_store4(&q1, quaternion_multiply(*this, v));
+#else
     float w1 = q1;
     float x1 = q2;
     float y1 = q3;
@@ -343,6 +373,7 @@ Quaternion &Quaternion::operator*=(const Quaternion &v)
     q2 = w1*x2 + x1*w2 + y1*z2 - z1*y2;
     q3 = w1*y2 - x1*z2 + y1*w2 + z1*x2;
     q4 = w1*z2 + x1*y2 - y1*x2 + z1*w2;
+#endif
 
     return *this;
 }
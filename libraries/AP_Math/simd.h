@@ -0,0 +1,158 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  4-lane float helpers used by the Matrix3f and Quaternion kernels.
+  They are only enabled when the build defines AP_MATH_SIMD (waf
+  configure --enable-math-simd) and the compiler targets SSE or NEON,
+  otherwise the scalar templates are used unchanged.
+
+  A Vector3f is held in lanes 0-2 with lane 3 zero. Loads and stores only
+  touch the 12 bytes of the vector, so no alignment or padding is needed
+  in the math classes.
+ */
+
+#ifndef AP_MATH_SIMD
+#define AP_MATH_SIMD 0
+#endif
+
+#if AP_MATH_SIMD
+#if defined(__SSE__)
+#define AP_MATH_SIMD_SSE 1
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AP_MATH_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+// no supported instruction set on this target, use the scalar code
+#undef AP_MATH_SIMD
+#define AP_MATH_SIMD 0
+#endif
+#endif
+
+#if defined(AP_MATH_SIMD_SSE)
+
+typedef __m128 simd_f4;
+
+static inline simd_f4 simd_load3(const float *p)
+{
+    const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)p);
+    return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+}
+
+static inline void simd_store3(float *p, simd_f4 v)
+{
+    _mm_storel_pi((__m64 *)p, v);
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+static inline simd_f4 simd_load4(const float *p) { return _mm_loadu_ps(p); }
+static inline void simd_store4(float *p, simd_f4 v) { _mm_storeu_ps(p, v); }
+static inline simd_f4 simd_set1(float f) { return _mm_set1_ps(f); }
+static inline simd_f4 simd_add(simd_f4 a, simd_f4 b) { return _mm_add_ps(a, b); }
+static inline simd_f4 simd_sub(simd_f4 a, simd_f4 b) { return _mm_sub_ps(a, b); }
+static inline simd_f4 simd_mul(simd_f4 a, simd_f4 b) { return _mm_mul_ps(a, b); }
+
+// returns a + b * c
+static inline simd_f4 simd_madd(simd_f4 a, simd_f4 b, simd_f4 c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); }
+
+// sum of all four lanes
+static inline float simd_hsum(simd_f4 v)
+{
+    const __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+// cross product of the first three lanes, lane 3 of the result is zero
+static inline simd_f4 simd_cross3(simd_f4 a, simd_f4 b)
+{
+    const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// lane permutations used by the quaternion product, for v = (w,x,y,z)
+// these return (x,w,z,y), (y,z,w,x) and (z,y,x,w)
+static inline simd_f4 simd_swap_pairs(simd_f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline simd_f4 simd_swap_halves(simd_f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+static inline simd_f4 simd_reverse(simd_f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+#elif defined(AP_MATH_SIMD_NEON)
+
+typedef float32x4_t simd_f4;
+
+static inline simd_f4 simd_load3(const float *p)
+{
+    return vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.0f), 0));
+}
+
+static inline void simd_store3(float *p, simd_f4 v)
+{
+    vst1_f32(p, vget_low_f32(v));
+    vst1_lane_f32(p + 2, vget_high_f32(v), 0);
+}
+
+static inline simd_f4 simd_load4(const float *p) { return vld1q_f32(p); }
+static inline void simd_store4(float *p, simd_f4 v) { vst1q_f32(p, v); }
+static inline simd_f4 simd_set1(float f) { return vdupq_n_f32(f); }
+static inline simd_f4 simd_add(simd_f4 a, simd_f4 b) { return vaddq_f32(a, b); }
+static inline simd_f4 simd_sub(simd_f4 a, simd_f4 b) { return vsubq_f32(a, b); }
+static inline simd_f4 simd_mul(simd_f4 a, simd_f4 b) { return vmulq_f32(a, b); }
+
+// returns a + b * c
+static inline simd_f4 simd_madd(simd_f4 a, simd_f4 b, simd_f4 c) { return vmlaq_f32(a, b, c); }
+
+// sum of all four lanes
+static inline float simd_hsum(simd_f4 v)
+{
+#if defined(__aarch64__)
+    return vaddvq_f32(v);
+#else
+    float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    s = vpadd_f32(s, s);
+    return vget_lane_f32(s, 0);
+#endif
+}
+
+// returns (y,z,x,y) for v = (x,y,z,w)
+static inline simd_f4 simd_yzx(simd_f4 v)
+{
+    return vcombine_f32(vext_f32(vget_low_f32(v), vget_high_f32(v), 1), vget_low_f32(v));
+}
+
+// cross product of the first three lanes, lane 3 of the result is zero
+static inline simd_f4 simd_cross3(simd_f4 a, simd_f4 b)
+{
+    const float32x4_t c = vmlsq_f32(vmulq_f32(a, simd_yzx(b)), simd_yzx(a), b);
+    return vsetq_lane_f32(0.0f, simd_yzx(c), 3);
+}
+
+// lane permutations used by the quaternion product, for v = (w,x,y,z)
+// these return (x,w,z,y), (y,z,w,x) and (z,y,x,w)
+static inline simd_f4 simd_swap_pairs(simd_f4 v) { return vrev64q_f32(v); }
+static inline simd_f4 simd_swap_halves(simd_f4 v) { return vextq_f32(v, v, 2); }
+static inline simd_f4 simd_reverse(simd_f4 v) { return vrev64q_f32(vextq_f32(v, v, 2)); }
+
+#endif // AP_MATH_SIMD_NEON
+
+#if AP_MATH_SIMD
+// length of the vector held in the first three lanes
+static inline float simd_length3(simd_f4 v)
+{
+    return sqrtf(simd_hsum(simd_mul(v, v)));
+}
+#endif
@@ -0,0 +1,137 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/chirp.h>
+#include <AP_Math/frequency_response.h>
+
+static const float dt = 1.0f / 2000.0f;
+
+TEST(ChirpTest, SweepsAndFades)
+{
+    Chirp chirp;
+    chirp.init(10.0f, 0.5f, 20.0f, 1.0f, 1.0f);
+
+    EXPECT_FLOAT_EQ(0.0f, chirp.update(0.0f, 1.0f));
+    EXPECT_NEAR(0.5f, chirp.get_frequency_hz(), 1e-4f);
+
+    // log sweep, halfway through the record is the geometric mean
+    chirp.update(5.0f, 1.0f);
+    EXPECT_NEAR(sqrtf(0.5f * 20.0f), chirp.get_frequency_hz(), 1e-3f);
+
+    EXPECT_NEAR(0.0f, chirp.update(10.0f, 1.0f), 1e-5f);
+    EXPECT_NEAR(20.0f, chirp.get_frequency_hz(), 1e-3f);
+    EXPECT_FALSE(chirp.completed());
+
+    EXPECT_FLOAT_EQ(0.0f, chirp.update(10.1f, 1.0f));
+    EXPECT_TRUE(chirp.completed());
+
+    // the magnitude is reached between the fades
+    float peak = 0.0f;
+    for (float t = 1.0f; t < 9.0f; t += dt) {
+        peak = MAX(peak, fabsf(chirp.update(t, 0.3f)));
+    }
+    EXPECT_NEAR(0.3f, peak, 1e-3f);
+}
+
+/*
+  inject a chirp into a system, step(d, input, output) advances the
+  system by dt with the chirp value d and gives the signals to measure
+ */
+template <typename F>
+static void measure(FrequencyResponse &fr, F step)
+{
+    Chirp chirp;
+    const float record = 20.0f;
+    chirp.init(record, 0.25f, 30.0f, 1.0f, 1.0f);
+    fr.init(0.5f, 15.0f, 12);
+    for (float t = 0; t < record; t += dt) {
+        float input, output;
+        step(chirp.update(t, 1.0f), input, output);
+        fr.update(input, output, dt);
+    }
+}
+
+TEST(FrequencyResponseTest, FirstOrderLag)
+{
+    // 1 / (tau s + 1)
+    const float tau = 1.0f / (M_2PI * 2.0f);
+    float y = 0.0f;
+    FrequencyResponse fr;
+    measure(fr, [&y, tau](float d, float &input, float &output) {
+        y += (d - y) * (1.0f - expf(-dt / tau));
+        input = d;
+        output = y;
+    });
+
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < fr.get_num_bins(); i++) {
+        float gain, phase;
+        if (!fr.get_response(i, gain, phase)) {
+            continue;
+        }
+        valid++;
+        const float wt = M_2PI * fr.get_frequency_hz(i) * tau;
+        EXPECT_NEAR(1.0f / sqrtf(1.0f + wt * wt), gain, 0.03f);
+        EXPECT_NEAR(degrees(-atanf(wt)), degrees(phase), 2.0f);
+    }
+    EXPECT_EQ(fr.get_num_bins(), valid);
+}
+
+TEST(FrequencyResponseTest, CrossoverAndBandwidth)
+{
+    // open loop K / (s (tau s + 1)), an integrator with a first order lag,
+    // closed with unity feedback and the chirp added to the loop input
+    // as ModeSystemId does. The open loop response is -u_c / u
+    const float K = M_2PI * 3.0f;
+    const float tau = 1.0f / (M_2PI * 10.0f);
+    float rate = 0.0f, angle = 0.0f;
+    FrequencyResponse fr;
+    measure(fr, [&rate, &angle, K, tau](float d, float &input, float &output) {
+        const float u_c = -angle;
+        const float u = u_c + d;
+        rate += (K * u - rate) * (1.0f - expf(-dt / tau));
+        angle += rate * dt;
+        input = u;
+        output = -u_c;
+    });
+
+    // crossover where K = w sqrt(1 + (w tau)^2)
+    const float w2 = (sqrtf(1.0f + 4.0f * sq(K * tau)) - 1.0f) / (2.0f * sq(tau));
+    const float wc = sqrtf(w2);
+    float freq, pm;
+    ASSERT_TRUE(fr.get_crossover(freq, pm));
+    EXPECT_NEAR(wc / M_2PI, freq, 0.03f * wc / M_2PI);
+    EXPECT_NEAR(90.0f - degrees(atanf(wc * tau)), pm, 2.0f);
+
+    // closed loop K / (tau s^2 + s + K), find the -3dB point by bisection
+    float lo = 0.1f, hi = 1000.0f;
+    for (uint8_t i = 0; i < 50; i++) {
+        const float w = 0.5f * (lo + hi);
+        const float gain = K / norm(K - tau * w * w, w);
+        if (gain > sqrtf(0.5f)) {
+            lo = w;
+        } else {
+            hi = w;
+        }
+    }
+    float bw;
+    ASSERT_TRUE(fr.get_closed_loop_bandwidth(bw));
+    EXPECT_NEAR(lo / M_2PI, bw, 0.03f * lo / M_2PI);
+}
+
+TEST(FrequencyResponseTest, NoInput)
+{
+    FrequencyResponse fr;
+    fr.init(1.0f, 10.0f, 5);
+    for (uint16_t i = 0; i < 1000; i++) {
+        fr.update(0.0f, 1.0f, dt);
+    }
+    float gain, phase, freq, pm;
+    EXPECT_FALSE(fr.get_response(0, gain, phase));
+    EXPECT_FALSE(fr.get_crossover(freq, pm));
+    EXPECT_FALSE(fr.get_closed_loop_bandwidth(freq));
+    EXPECT_NEAR(1.0f, fr.get_frequency_hz(0), 1e-5f);
+    EXPECT_NEAR(10.0f, fr.get_frequency_hz(4), 1e-4f);
+}
+
+AP_GTEST_MAIN()
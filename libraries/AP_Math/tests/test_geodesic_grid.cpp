@@ -68,6 +68,14 @@ protected:
                 ASSERT_EQ(-1, subtriangle) << "triangle is " << triangle;
             }
         }
+
+        /* The lookup table may give up on a vector, but must never give a
+         * different triangle */
+        int lookup_triangle = AP_GeodesicGrid::_triangle_index_lookup(p.v);
+        if (lookup_triangle >= 0) {
+            ASSERT_EQ(AP_GeodesicGrid::_triangle_index(p.v, false),
+                      lookup_triangle);
+        }
     }
 };
 
@@ -143,6 +151,10 @@ TEST_P(GeodesicGridTest, Sections)
     test_triangles_indexes(p);
     EXPECT_EQ(p.section, AP_GeodesicGrid::section(p.v));
 
+    int batch_section;
+    AP_GeodesicGrid::sections(&p.v, &batch_section, 1);
+    EXPECT_EQ(p.section, batch_section);
+
     if (p.section < 0) {
         int s = AP_GeodesicGrid::section(p.v, true);
         int i;
@@ -232,4 +244,61 @@ INSTANTIATE_TEST_CASE_P(HardcodedVectors,
                         GeodesicGridTest,
                         ::testing::ValuesIn(hardcoded_vectors));
 
+/* The batch version must give the same results as section() for each vector,
+ * whether the lookup table resolves it or not */
+TEST(GeodesicGridBatchTest, SectionsMatchSection)
+{
+    std::vector<Vector3f> v;
+    for (auto &p : icosahedron_vertices) {
+        v.push_back(p.v);
+    }
+    for (auto &p : general_vectors) {
+        v.push_back(p.v);
+    }
+    for (auto &p : hardcoded_vectors) {
+        v.push_back(p.v);
+    }
+    /* Null vector and vectors on the coordinate planes */
+    v.push_back(Vector3f());
+    v.push_back(Vector3f(1.0f, 0.0f, 0.0f));
+    v.push_back(Vector3f(0.0f, -1.0f, 1.0f));
+    v.push_back(Vector3f(1.0f, 1.0f, -1.0f));
+
+    std::vector<int> s(v.size());
+    for (bool inclusive : {false, true}) {
+        AP_GeodesicGrid::sections(v.data(), s.data(), v.size(), inclusive);
+        for (size_t i = 0; i < v.size(); i++) {
+            EXPECT_EQ(AP_GeodesicGrid::section(v[i], inclusive), s[i])
+                << "vector " << v[i] << " inclusive " << inclusive;
+        }
+    }
+}
+
+/* NaN or infinity in any coordinate must be left to the full search rather
+ * than index outside the lookup table */
+TEST(GeodesicGridBatchTest, NotFinite)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    const Vector3f v[] = {
+        {1.0f, nan, 2.0f},
+        {nan, 1.0f, 2.0f},
+        {2.0f, 1.0f, nan},
+        {nan, nan, nan},
+        {1.0f, inf, nan},
+        {nan, inf, 1.0f},
+        {inf, 1.0f, 2.0f},
+        {-inf, inf, 0.0f},
+    };
+    const uint16_t count = sizeof(v) / sizeof(v[0]);
+    int s[count];
+    for (bool inclusive : {false, true}) {
+        AP_GeodesicGrid::sections(v, s, count, inclusive);
+        for (uint16_t i = 0; i < count; i++) {
+            EXPECT_EQ(AP_GeodesicGrid::section(v[i], inclusive), s[i])
+                << "vector " << v[i] << " inclusive " << inclusive;
+        }
+    }
+}
+
 AP_GTEST_MAIN()
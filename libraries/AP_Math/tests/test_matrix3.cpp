@@ -96,6 +96,58 @@ TEST_P(Matrix3fTest, Inverses)
     }
 }
 
+TEST(Matrix3fProductTest, VectorProducts)
+{
+    const Matrix3f m({1.0f, 2.0f, 3.0f},
+                     {4.0f, 5.0f, 6.0f},
+                     {7.0f, 8.0f, 9.0f});
+    const Vector3f v(1.0f, -2.0f, 0.5f);
+
+    const Vector3f mv = m * v;
+    EXPECT_FLOAT_EQ(-1.5f, mv.x);
+    EXPECT_FLOAT_EQ(-3.0f, mv.y);
+    EXPECT_FLOAT_EQ(-4.5f, mv.z);
+
+    const Vector3f mtv = m.mul_transpose(v);
+    EXPECT_FLOAT_EQ(-3.5f, mtv.x);
+    EXPECT_FLOAT_EQ(-4.0f, mtv.y);
+    EXPECT_FLOAT_EQ(-4.5f, mtv.z);
+}
+
+TEST(Matrix3fProductTest, MatrixProduct)
+{
+    const Matrix3f m1({1.0f, 2.0f, 3.0f},
+                      {4.0f, 5.0f, 6.0f},
+                      {7.0f, 8.0f, 9.0f});
+    const Matrix3f m2({-1.0f, 0.5f, 2.0f},
+                      { 3.0f, 1.0f, 0.0f},
+                      { 0.0f, 2.0f, -1.0f});
+
+    const Matrix3f p = m1 * m2;
+    EXPECT_FLOAT_EQ( 5.0f, p.a.x);
+    EXPECT_FLOAT_EQ( 8.5f, p.a.y);
+    EXPECT_FLOAT_EQ(-1.0f, p.a.z);
+    EXPECT_FLOAT_EQ(11.0f, p.b.x);
+    EXPECT_FLOAT_EQ(19.0f, p.b.y);
+    EXPECT_FLOAT_EQ( 2.0f, p.b.z);
+    EXPECT_FLOAT_EQ(17.0f, p.c.x);
+    EXPECT_FLOAT_EQ(29.5f, p.c.y);
+    EXPECT_FLOAT_EQ( 5.0f, p.c.z);
+}
+
+TEST(Matrix3fProductTest, RotateNormalize)
+{
+    Matrix3f m;
+    m.identity();
+    m.rotate(Vector3f(0.01f, -0.02f, 0.03f));
+    m.normalize();
+
+    // rows and columns must stay orthonormal
+    const Matrix3f identity = m * m.transposed();
+    AP_EXPECT_IDENTITY_MATRIX(identity);
+    EXPECT_NEAR(1.0f, m.det(), 1.0e-6);
+}
+
 INSTANTIATE_TEST_CASE_P(InvertibleMatrices,
                         Matrix3fTest,
                         ::testing::ValuesIn(invertible));
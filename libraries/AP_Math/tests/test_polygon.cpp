@@ -0,0 +1,95 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  a closed star shaped polygon in cm, similar to a large survey fence.
+  The last point repeats the first as required by Polygon_outside()
+ */
+static uint16_t make_fence(Vector2f *V, uint16_t n)
+{
+    for (uint16_t i = 0; i < n - 1; i++) {
+        const float angle = i * M_2PI / (n - 1);
+        const float radius = 40000.0f + ((i % 2) ? 15000.0f : 0.0f) + 5000.0f * sinf(7 * angle);
+        V[i] = Vector2f(radius * cosf(angle), 0.5f * radius * sinf(angle));
+    }
+    V[n - 1] = V[0];
+    return n;
+}
+
+TEST(PolygonIndexTest, MatchesLinearOutside)
+{
+    const uint16_t sizes[] = { 4, 5, 17, 100, 255 };
+    for (const uint16_t n : sizes) {
+        Vector2f V[255];
+        make_fence(V, n);
+        AP_PolygonIndex index;
+        ASSERT_TRUE(index.build(V, n));
+        for (float x = -60000.0f; x <= 60000.0f; x += 730.0f) {
+            for (float y = -35000.0f; y <= 35000.0f; y += 410.0f) {
+                const Vector2f P(x, y);
+                EXPECT_EQ(Polygon_outside(P, V, n), index.outside(P)) << "n=" << n << " x=" << x << " y=" << y;
+            }
+        }
+        // points on the vertices exercise the edges shared between cells
+        for (uint16_t i = 0; i < n; i++) {
+            EXPECT_EQ(Polygon_outside(V[i], V, n), index.outside(V[i])) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(PolygonIndexTest, EdgesInBox)
+{
+    const uint16_t n = 200;
+    Vector2f V[n];
+    make_fence(V, n);
+    AP_PolygonIndex index;
+    ASSERT_TRUE(index.build(V, n));
+
+    for (float x = -60000.0f; x <= 60000.0f; x += 3100.0f) {
+        for (float y = -35000.0f; y <= 35000.0f; y += 2300.0f) {
+            const Vector2f min(x, y);
+            const Vector2f max(x + 2500.0f, y + 1200.0f);
+            AP_PolygonIndex::EdgeSet edges;
+            const uint16_t count = index.edges_in_box(min, max, edges);
+            uint16_t set = 0;
+            for (uint16_t i = 0, j = n - 1; i < n; j = i++) {
+                const bool found = (edges.bits[i / 32] & (1U << (i % 32))) != 0;
+                set += found ? 1 : 0;
+                // every edge whose bounding box overlaps must be returned
+                const bool overlaps = MIN(V[i].x, V[j].x) <= max.x && MAX(V[i].x, V[j].x) >= min.x &&
+                                      MIN(V[i].y, V[j].y) <= max.y && MAX(V[i].y, V[j].y) >= min.y;
+                if (overlaps) {
+                    EXPECT_TRUE(found) << "edge " << i << " x=" << x << " y=" << y;
+                }
+            }
+            EXPECT_EQ(set, count);
+            // and the grid should be discarding most of the others
+            EXPECT_LT(count, n / 4);
+        }
+    }
+}
+
+TEST(PolygonIndexTest, Limits)
+{
+    AP_PolygonIndex index;
+    EXPECT_FALSE(index.valid());
+    EXPECT_TRUE(index.outside(Vector2f()));
+
+    Vector2f V[AP_POLYGON_INDEX_MAX_EDGES + 1];
+    make_fence(V, ARRAY_SIZE(V));
+    EXPECT_FALSE(index.build(V, ARRAY_SIZE(V)));
+    EXPECT_FALSE(index.build(V, 2));
+    EXPECT_FALSE(index.valid());
+
+    // a degenerate polygon with no height
+    const Vector2f line[] = { {0, 0}, {100, 0}, {200, 0}, {0, 0} };
+    ASSERT_TRUE(index.build(line, ARRAY_SIZE(line)));
+    EXPECT_TRUE(index.outside(Vector2f(50, 0)));
+    EXPECT_TRUE(index.outside(Vector2f(50, 10)));
+
+    index.clear();
+    EXPECT_FALSE(index.valid());
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,70 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "math_test.h"
+
+TEST(QuaternionTest, Product)
+{
+    const Quaternion q1(1.0f, 2.0f, 3.0f, 4.0f);
+    const Quaternion q2(5.0f, 6.0f, 7.0f, 8.0f);
+
+    const Quaternion p = q1 * q2;
+    EXPECT_FLOAT_EQ(-60.0f, p.q1);
+    EXPECT_FLOAT_EQ( 12.0f, p.q2);
+    EXPECT_FLOAT_EQ( 30.0f, p.q3);
+    EXPECT_FLOAT_EQ( 24.0f, p.q4);
+
+    Quaternion q3 = q1;
+    q3 *= q2;
+    EXPECT_FLOAT_EQ(p.q1, q3.q1);
+    EXPECT_FLOAT_EQ(p.q2, q3.q2);
+    EXPECT_FLOAT_EQ(p.q3, q3.q3);
+    EXPECT_FLOAT_EQ(p.q4, q3.q4);
+}
+
+TEST(QuaternionTest, ProductMatchesRotationMatrix)
+{
+    Quaternion q1, q2;
+    q1.from_euler(0.1f, -0.4f, 1.2f);
+    q2.from_euler(-0.3f, 0.2f, -2.0f);
+
+    Matrix3f m1, m2, m;
+    q1.rotation_matrix(m1);
+    q2.rotation_matrix(m2);
+    (q1 * q2).rotation_matrix(m);
+
+    const Matrix3f expected = m1 * m2;
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_NEAR(expected[i].x, m[i].x, 1.0e-6);
+        EXPECT_NEAR(expected[i].y, m[i].y, 1.0e-6);
+        EXPECT_NEAR(expected[i].z, m[i].z, 1.0e-6);
+    }
+}
+
+TEST(QuaternionTest, Normalize)
+{
+    Quaternion q(1.0f, -2.0f, 2.0f, 4.0f);
+    q.normalize();
+    EXPECT_FLOAT_EQ( 0.2f, q.q1);
+    EXPECT_FLOAT_EQ(-0.4f, q.q2);
+    EXPECT_FLOAT_EQ( 0.4f, q.q3);
+    EXPECT_FLOAT_EQ( 0.8f, q.q4);
+
+    Quaternion zero(0.0f, 0.0f, 0.0f, 0.0f);
+    zero.normalize();
+    EXPECT_FLOAT_EQ(0.0f, zero.length());
+}
+
+AP_GTEST_MAIN()
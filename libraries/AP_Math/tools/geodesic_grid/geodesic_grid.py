@@ -136,6 +136,14 @@ Generate C++ code for the initialization of members _inverses and _mid_inverses
 declared in AP_GeodesicGrid.h.
 """)
 
+parser.add_argument(
+    '--lookup-gen',
+    action='store_true',
+    help="""
+Generate C++ code for the initialization of the member _lookup declared in
+AP_GeodesicGrid.h.
+""")
+
 
 args = parser.parse_args()
 
@@ -308,6 +316,50 @@ if args.inverses_gen:
         print("     {%9.6ff, %9.6ff, %9.6ff}}," % (m[2,0], m[2,1], m[2,2]))
     print("};")
 
+if args.lookup_gen:
+    # Must match LOOKUP_CELLS in AP_GeodesicGrid.h
+    cells = 16
+    # Points sampled along each side of a cell
+    samples = 8
+
+    # The icosahedron is regular, so a vector crosses the triangle whose
+    # centroid gives the greatest dot product
+    centroids = [a + b + c for a, b, c in ico.triangles]
+
+    def triangle_index(v):
+        dots = [v[0] * c.x + v[1] * c.y + v[2] * c.z for c in centroids]
+        return dots.index(max(dots))
+
+    def cell_point(face, p, q):
+        axis, sign = face // 2, -1 if face % 2 else 1
+        return (
+            (sign, p, q),
+            (p, sign, q),
+            (p, q, sign),
+        )[axis]
+
+    def cell_triangle(face, i, j):
+        """ Return the triangle that covers most of the cell """
+        count = [0] * len(ico.triangles)
+        for si in range(samples):
+            for sj in range(samples):
+                p = -1 + 2.0 * (i + (si + .5) / samples) / cells
+                q = -1 + 2.0 * (j + (sj + .5) / samples) / cells
+                count[triangle_index(cell_point(face, p, q))] += 1
+        return count.index(max(count))
+
+    print("Lookup table code generation:")
+    print_code_gen_notice()
+    print("const uint8_t AP_GeodesicGrid::_lookup[6][LOOKUP_CELLS][LOOKUP_CELLS]{")
+    for face in range(6):
+        print("    {")
+        for i in range(cells):
+            print("        {%s}," % ", ".join(
+                "%2d" % cell_triangle(face, i, j) for j in range(cells)
+            ))
+        print("    },")
+    print("};")
+
 
 if args.icosahedron:
     print('Icosahedron:')
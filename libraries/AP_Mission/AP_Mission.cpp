@@ -51,6 +51,9 @@ void AP_Mission::init()
     // changes in Content size break the storage
     static_assert(sizeof(union Content) == 12, "AP_Mission: Content must be 12 bytes");
 
+    // mirror the command list in RAM
+    init_cmd_cache();
+
     // If Mission Clear bit is set then it should clear the mission, otherwise retain the mission.
     if (AP_MISSION_MASK_MISSION_CLEAR & _options) {
     	gcs().send_text(MAV_SEVERITY_INFO, "Clearing Mission");
@@ -304,6 +307,31 @@ bool AP_Mission::is_nav_cmd(const Mission_Command& cmd)
 ///     returns true if found, false if not found (i.e. reached end of mission command list)
 ///     accounts for do_jump commands but never increments the jump's num_times_run (advance_current_nav_cmd is responsible for this)
 bool AP_Mission::get_next_nav_cmd(uint16_t start_index, Mission_Command& cmd)
+{
+    // search the command list if the successor is not cached
+    if (start_index >= _cmd_cache_size) {
+        return find_next_nav_cmd(start_index, cmd);
+    }
+
+    // the parameter may have been changed directly
+    if (_nav_successor_cmd_total != _cmd_total) {
+        invalidate_nav_successors();
+    }
+
+    uint16_t next_index = _nav_successor[start_index];
+    if (next_index == AP_MISSION_CMD_INDEX_UNKNOWN) {
+        next_index = find_next_nav_cmd(start_index, cmd) ? cmd.index : AP_MISSION_CMD_INDEX_NONE;
+        _nav_successor[start_index] = next_index;
+        return next_index != AP_MISSION_CMD_INDEX_NONE;
+    }
+    if (next_index == AP_MISSION_CMD_INDEX_NONE) {
+        return false;
+    }
+    return read_cmd_from_storage(next_index, cmd);
+}
+
+/// find_next_nav_cmd - searches the command list for the next "navigation" command at or after start_index
+bool AP_Mission::find_next_nav_cmd(uint16_t start_index, Mission_Command& cmd)
 {
     uint16_t cmd_index = start_index;
 
@@ -474,31 +502,40 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         cmd.id = MAV_CMD_NAV_WAYPOINT;
         cmd.p1 = 0;
         cmd.content.location = _ahrs.get_home();
+    }else if (index < _cmd_cache_size) {
+        // use the copy decoded when the command was last loaded or written
+        cmd = _cmd_cache[index];
     }else{
-        // Find out proper location in memory by using the start_byte position + the index
-        // we can load a command, we don't process it yet
-        // read WP position
-        uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
-
-        uint8_t b1 = _storage.read_byte(pos_in_storage);
-        if (b1 == 0) {
-            cmd.id = _storage.read_uint16(pos_in_storage+1);
-            cmd.p1 = _storage.read_uint16(pos_in_storage+3);
-            _storage.read_block(cmd.content.bytes, pos_in_storage+5, 10);
-        } else {
-            cmd.id = b1;
-            cmd.p1 = _storage.read_uint16(pos_in_storage+1);
-            _storage.read_block(cmd.content.bytes, pos_in_storage+3, 12);
-        }
-
-        // set command's index to it's position in eeprom
-        cmd.index = index;
+        decode_cmd_from_storage(index, cmd);
     }
 
     // return success
     return true;
 }
 
+/// decode_cmd_from_storage - decodes command at index (not home) from storage
+void AP_Mission::decode_cmd_from_storage(uint16_t index, Mission_Command& cmd) const
+{
+    // Find out proper location in memory by using the start_byte position + the index
+    // we can load a command, we don't process it yet
+    // read WP position
+    uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+
+    uint8_t b1 = _storage.read_byte(pos_in_storage);
+    if (b1 == 0) {
+        cmd.id = _storage.read_uint16(pos_in_storage+1);
+        cmd.p1 = _storage.read_uint16(pos_in_storage+3);
+        _storage.read_block(cmd.content.bytes, pos_in_storage+5, 10);
+    } else {
+        cmd.id = b1;
+        cmd.p1 = _storage.read_uint16(pos_in_storage+1);
+        _storage.read_block(cmd.content.bytes, pos_in_storage+3, 12);
+    }
+
+    // set command's index to it's position in eeprom
+    cmd.index = index;
+}
+
 /// write_cmd_to_storage - write a command to storage
 ///     index is used to calculate the storage location
 ///     true is returned if successful
@@ -524,6 +561,12 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, Mission_Command& cmd)
         _storage.write_block(pos_in_storage+5, cmd.content.bytes, 10);
     }
 
+    // keep the RAM mirror in step with storage
+    if (index < _cmd_cache_size) {
+        decode_cmd_from_storage(index, _cmd_cache[index]);
+        invalidate_nav_successors();
+    }
+
     // remember when the mission last changed
     _last_change_time_ms = AP_HAL::millis();
 
@@ -1620,6 +1663,9 @@ void AP_Mission::init_jump_tracking()
         _jump_tracking[i].index = AP_MISSION_CMD_INDEX_NONE;
         _jump_tracking[i].num_times_run = 0;
     }
+
+    // nav command successors depend on how many times each jump has run
+    invalidate_nav_successors();
 }
 
 /// get_jump_times_run - returns number of times the jump command has been run
@@ -1661,11 +1707,13 @@ void AP_Mission::increment_jump_times_run(Mission_Command& cmd)
     for (uint8_t i=0; i<AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS; i++) {
         if (_jump_tracking[i].index == cmd.index) {
             _jump_tracking[i].num_times_run++;
+            invalidate_nav_successors();
             return;
         }else if(_jump_tracking[i].index == AP_MISSION_CMD_INDEX_NONE) {
             // we've searched through all known jump commands and haven't found it so allocate new space in _jump_tracking array
             _jump_tracking[i].index = cmd.index;
             _jump_tracking[i].num_times_run = 1;
+            invalidate_nav_successors();
             return;
         }
     }
@@ -1675,6 +1723,47 @@ void AP_Mission::increment_jump_times_run(Mission_Command& cmd)
     return;
 }
 
+/// init_cmd_cache - allocates the RAM mirror of the command list and fills it from storage
+///     commands are mirrored up to the storage capacity, not just _cmd_total, so
+///     the mirror stays valid whatever the total is later set to
+void AP_Mission::init_cmd_cache()
+{
+    if (_cmd_cache != nullptr) {
+        return;
+    }
+
+    const uint16_t cache_size = MIN(num_commands_max(), (uint16_t)AP_MISSION_CMD_CACHE_SIZE);
+    if (cache_size == 0) {
+        return;
+    }
+    _cmd_cache = new Mission_Command[cache_size];
+    _nav_successor = new uint16_t[cache_size];
+    if (_cmd_cache == nullptr || _nav_successor == nullptr) {
+        // fall back to reading every command from storage
+        delete[] _cmd_cache;
+        delete[] _nav_successor;
+        _cmd_cache = nullptr;
+        _nav_successor = nullptr;
+        return;
+    }
+
+    // command 0 is home and is never taken from the mirror
+    for (uint16_t i=1; i<cache_size; i++) {
+        decode_cmd_from_storage(i, _cmd_cache[i]);
+    }
+    _cmd_cache_size = cache_size;
+    invalidate_nav_successors();
+}
+
+/// invalidate_nav_successors - forget the cached nav command successors
+void AP_Mission::invalidate_nav_successors()
+{
+    for (uint16_t i=0; i<_cmd_cache_size; i++) {
+        _nav_successor[i] = AP_MISSION_CMD_INDEX_UNKNOWN;
+    }
+    _nav_successor_cmd_total = _cmd_total;
+}
+
 // check_eeprom_version - checks version of missions stored in eeprom matches this library
 // command list will be cleared if they do not match
 void AP_Mission::check_eeprom_version()
@@ -40,6 +40,16 @@
 #define AP_MISSION_OPTIONS_DEFAULT          0       // Do not clear the mission when rebooting
 #define AP_MISSION_MASK_MISSION_CLEAR       (1<<0)  // If set then Clear the mission on boot
 
+// number of commands mirrored in RAM after being decoded from storage.  Commands beyond this are read from storage
+#ifndef AP_MISSION_CMD_CACHE_SIZE
+#if HAL_MINIMIZE_FEATURES
+#define AP_MISSION_CMD_CACHE_SIZE           0
+#else
+#define AP_MISSION_CMD_CACHE_SIZE           128
+#endif
+#endif
+#define AP_MISSION_CMD_INDEX_UNKNOWN        65534   // nav command successor has not been calculated
+
 /// @class    AP_Mission
 /// @brief    Object managing Mission
 class AP_Mission {
@@ -289,7 +299,11 @@ public:
         _prev_nav_cmd_id(AP_MISSION_CMD_ID_NONE),
         _prev_nav_cmd_index(AP_MISSION_CMD_INDEX_NONE),
         _prev_nav_cmd_wp_index(AP_MISSION_CMD_INDEX_NONE),
-        _last_change_time_ms(0)
+        _last_change_time_ms(0),
+        _cmd_cache(nullptr),
+        _nav_successor(nullptr),
+        _cmd_cache_size(0),
+        _nav_successor_cmd_total(0)
     {
         // load parameter defaults
         AP_Param::setup_object_defaults(this, var_info);
@@ -497,6 +511,10 @@ private:
     ///     increment_jump_num_times_if_found should be set to true if advancing the active navigation command
     bool get_next_cmd(uint16_t start_index, Mission_Command& cmd, bool increment_jump_num_times_if_found);
 
+    /// find_next_nav_cmd - searches the command list for the next "navigation" command at or after start_index
+    ///     used by get_next_nav_cmd when the result is not already known
+    bool find_next_nav_cmd(uint16_t start_index, Mission_Command& cmd);
+
     /// get_next_do_cmd - gets next "do" or "conditional" command after start_index
     ///     returns true if found, false if not found
     ///     stops and returns false if it hits another navigation command before it finds the first do or conditional command
@@ -516,6 +534,18 @@ private:
     /// increment_jump_times_run - increments the recorded number of times the jump command has been run
     void increment_jump_times_run(Mission_Command& cmd);
 
+    ///
+    /// command cache methods
+    ///
+    /// init_cmd_cache - allocates the RAM mirror of the command list and fills it from storage
+    void init_cmd_cache();
+
+    /// invalidate_nav_successors - forget the cached nav command successors, called when the mission or jump state changes
+    void invalidate_nav_successors();
+
+    /// decode_cmd_from_storage - decodes command at index (not home) from storage
+    void decode_cmd_from_storage(uint16_t index, Mission_Command& cmd) const;
+
     /// check_eeprom_version - checks version of missions stored in eeprom matches this library
     /// command list will be cleared if they do not match
     void check_eeprom_version();
@@ -551,4 +581,12 @@ private:
 
     // last time that mission changed
     uint32_t _last_change_time_ms;
+
+    // RAM mirror of the first _cmd_cache_size commands, and for each of
+    // those the index of the next nav command at or after it
+    // (AP_MISSION_CMD_INDEX_UNKNOWN until first requested)
+    Mission_Command *_cmd_cache;
+    uint16_t *_nav_successor;
+    uint16_t _cmd_cache_size;
+    int16_t _nav_successor_cmd_total;   // _cmd_total when the nav successors were calculated
 };
@@ -307,6 +307,10 @@ void AP_MotorsHeli::output_min()
 // output - sends commands to the servos
 void AP_MotorsHeli::output()
 {
+    // group the swash, tail and throttle outputs so they reach the
+    // servos together. This nests inside any cork held by the vehicle
+    SRV_Channels::cork();
+
     // update throttle filter
     update_throttle_filter();
 
@@ -320,6 +324,8 @@ void AP_MotorsHeli::output()
     } else {
         output_disarmed();
     }
+
+    SRV_Channels::push();
 };
 
 // sends commands to the motors
@@ -0,0 +1,62 @@
+/*
+  IMU data shared by the EKF2 and EKF3 cores
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AP_NavEKF_IMUFrontend.h"
+
+const NavEKF_IMUFrontend::GyroSample *NavEKF_IMUFrontend::gyro(uint8_t ins_index)
+{
+    const AP_InertialSensor &ins = AP::ins();
+    if (ins_index >= ins.get_gyro_count()) {
+        return nullptr;
+    }
+    GyroSample &s = _gyro[ins_index];
+    const uint32_t update_us = ins.get_last_update_usec();
+    if (!(_gyro_valid_mask & (1U<<ins_index)) || _gyro_update_us[ins_index] != update_us) {
+        ins.get_delta_angle(ins_index, s.delAng);
+        s.delAngDT = ins.get_delta_angle_dt(ins_index);
+        s.delQuat.from_axis_angle(s.delAng);
+        _gyro_update_us[ins_index] = update_us;
+        _gyro_valid_mask |= (1U<<ins_index);
+    }
+    return &s;
+}
+
+const NavEKF_IMUFrontend::AccelSample *NavEKF_IMUFrontend::accel(uint8_t ins_index)
+{
+    const AP_InertialSensor &ins = AP::ins();
+    if (ins_index >= ins.get_accel_count()) {
+        return nullptr;
+    }
+    AccelSample &s = _accel[ins_index];
+    const uint32_t update_us = ins.get_last_update_usec();
+    if (!(_accel_valid_mask & (1U<<ins_index)) || _accel_update_us[ins_index] != update_us) {
+        ins.get_delta_velocity(ins_index, s.delVel);
+        s.delVelDT = ins.get_delta_velocity_dt(ins_index);
+        _accel_update_us[ins_index] = update_us;
+        _accel_valid_mask |= (1U<<ins_index);
+    }
+    return &s;
+}
+
+namespace AP {
+
+NavEKF_IMUFrontend &ekf_imu()
+{
+    static NavEKF_IMUFrontend _ekf_imu;
+    return _ekf_imu;
+}
+
+};
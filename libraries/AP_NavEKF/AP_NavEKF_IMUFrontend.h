@@ -0,0 +1,59 @@
+/*
+  IMU data shared by the EKF2 and EKF3 cores
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+#include <AP_InertialSensor/AP_InertialSensor.h>
+
+/*
+  reads the delta angles and velocities for each IMU once per INS
+  update, along with the rotation through each delta angle which the
+  cores need when downsampling. Every core of both filters which uses
+  the same IMU then shares one read and one axis-angle conversion,
+  which is most of the per sample cost when EKF2 and EKF3 run together
+ */
+class NavEKF_IMUFrontend {
+public:
+    struct GyroSample {
+        Vector3f delAng;    // rad
+        float delAngDT;     // s, not limited
+        Quaternion delQuat; // rotation through delAng
+    };
+
+    struct AccelSample {
+        Vector3f delVel;    // m/s
+        float delVelDT;     // s, not limited
+    };
+
+    // latest sample from an IMU, or nullptr if there is no such IMU
+    const GyroSample *gyro(uint8_t ins_index);
+    const AccelSample *accel(uint8_t ins_index);
+
+private:
+    GyroSample _gyro[INS_MAX_INSTANCES];
+    AccelSample _accel[INS_MAX_INSTANCES];
+
+    // INS update time each sample was read at, and which are valid
+    uint32_t _gyro_update_us[INS_MAX_INSTANCES];
+    uint32_t _accel_update_us[INS_MAX_INSTANCES];
+    uint8_t _gyro_valid_mask;
+    uint8_t _accel_valid_mask;
+};
+
+namespace AP {
+    NavEKF_IMUFrontend &ekf_imu();
+};
@@ -7,6 +7,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_RangeFinder/RangeFinder_Backend.h>
+#include <AP_NavEKF/AP_NavEKF_IMUFrontend.h>
 
 #include <stdio.h>
 
@@ -336,7 +337,8 @@ void NavEKF2_core::readIMUData()
     imuDataNew.accel_index = accel_index_active;
 
     // Get delta angle data from primary gyro or primary if not available
-    readDeltaAngle(gyro_index_active, imuDataNew.delAng, imuDataNew.delAngDT);
+    Quaternion delQuat;
+    readDeltaAngle(gyro_index_active, imuDataNew.delAng, imuDataNew.delAngDT, delQuat);
     imuDataNew.gyro_index = gyro_index_active;
 
     // Get current time stamp
@@ -354,7 +356,7 @@ void NavEKF2_core::readIMUData()
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    imuQuatDownSampleNew *= delQuat;
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
@@ -431,11 +433,11 @@ void NavEKF2_core::readIMUData()
 // read the delta velocity and corresponding time interval from the IMU
 // return false if data is not available
 bool NavEKF2_core::readDeltaVelocity(uint8_t ins_index, Vector3f &dVel, float &dVel_dt) {
-    const AP_InertialSensor &ins = AP::ins();
+    const NavEKF_IMUFrontend::AccelSample *sample = AP::ekf_imu().accel(ins_index);
 
-    if (ins_index < ins.get_accel_count()) {
-        ins.get_delta_velocity(ins_index,dVel);
-        dVel_dt = MAX(ins.get_delta_velocity_dt(ins_index),1.0e-4f);
+    if (sample != nullptr) {
+        dVel = sample->delVel;
+        dVel_dt = MAX(sample->delVelDT,1.0e-4f);
         dVel_dt = MIN(dVel_dt,1.0e-1f);
         return true;
     }
@@ -589,16 +591,18 @@ void NavEKF2_core::readGpsData()
 
 // read the delta angle and corresponding time interval from the IMU
 // return false if data is not available
-bool NavEKF2_core::readDeltaAngle(uint8_t ins_index, Vector3f &dAng, float &dAng_dt) {
-    const AP_InertialSensor &ins = AP::ins();
+bool NavEKF2_core::readDeltaAngle(uint8_t ins_index, Vector3f &dAng, float &dAng_dt, Quaternion &dQuat) {
+    const NavEKF_IMUFrontend::GyroSample *sample = AP::ekf_imu().gyro(ins_index);
 
-    if (ins_index < ins.get_gyro_count()) {
-        ins.get_delta_angle(ins_index,dAng);
+    if (sample != nullptr) {
+        dAng = sample->delAng;
+        dQuat = sample->delQuat;
         frontend->logging.log_imu = true;
-        dAng_dt = MAX(ins.get_delta_angle_dt(ins_index),1.0e-4f);
+        dAng_dt = MAX(sample->delAngDT,1.0e-4f);
         dAng_dt = MIN(dAng_dt,1.0e-1f);
         return true;
     }
+    dQuat.from_axis_angle(dAng);
     return false;
 }
 
@@ -588,7 +588,7 @@ private:
 
     // helper functions for readIMUData
     bool readDeltaVelocity(uint8_t ins_index, Vector3f &dVel, float &dVel_dt);
-    bool readDeltaAngle(uint8_t ins_index, Vector3f &dAng, float &dAng_dt);
+    bool readDeltaAngle(uint8_t ins_index, Vector3f &dAng, float &dAng_dt, Quaternion &dQuat);
 
     // helper functions for correcting IMU data
     void correctDeltaAngle(Vector3f &delAng, float delAngDT, uint8_t gyro_index);
@@ -1,8 +1,64 @@
 // EKF Buffer models
 
+// maximum number of elements held by an observation buffer. Must be a power of two
+#define EKF_OBS_BUFFER_MAX 256
+
+// this is a simple bump allocator used to carve all of the buffers of
+// an EKF core out of a single block of memory. The block is allocated
+// once and reused if the buffers are set up again, so buffer setup
+// never fragments the heap
+class ekf_arena_t
+{
+public:
+    // round a request up so every block carved from the arena is suitably aligned
+    static uint32_t aligned_size(uint32_t size)
+    {
+        return (size + 7U) & ~7U;
+    }
+
+    // allocate the backing storage, returns false when allocation has failed
+    bool init(uint32_t size)
+    {
+        size = aligned_size(size);
+        if (_base == nullptr || _size < size) {
+            delete[] _base;
+            _base = new uint8_t[size];
+            if (_base == nullptr) {
+                _size = 0;
+                return false;
+            }
+            _size = size;
+        }
+        _used = 0;
+        return true;
+    }
+
+    // return a zeroed block from the arena, nullptr if the arena is exhausted
+    void *alloc(uint32_t size)
+    {
+        size = aligned_size(size);
+        if (_base == nullptr || _used + size > _size) {
+            return nullptr;
+        }
+        void *ret = &_base[_used];
+        _used += size;
+        memset(ret, 0, size);
+        return ret;
+    }
+
+private:
+    uint8_t *_base = nullptr;
+    uint32_t _size = 0;
+    uint32_t _used = 0;
+};
+
 // this buffer model is to be used for observation buffers,
 // the data is pushed into buffer like any standard ring buffer
 // return is based on the sample time provided
+// The capacity is rounded up to a power of two so indexes wrap with a mask.
+// Where observations are pushed in time order recall() can binary search
+// on the timestamp instead of scanning from the tail, otherwise use
+// recall_unordered()
 template <typename element_type>
 class obs_ring_buffer_t
 {
@@ -11,72 +67,105 @@ public:
         element_type element;
     } *buffer;
 
-    // initialise buffer, returns false when allocation has failed
-    bool init(uint32_t size)
+    // returns the number of elements allocated for a requested buffer length
+    static uint16_t capacity(uint32_t size)
     {
-        buffer = new element_t[size];
-        if(buffer == nullptr)
-        {
+        uint16_t ret = 1;
+        while (ret < size && ret < EKF_OBS_BUFFER_MAX) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    // returns the arena space required for a requested buffer length
+    static uint32_t storage_size(uint32_t size)
+    {
+        return ekf_arena_t::aligned_size(capacity(size) * sizeof(element_t));
+    }
+
+    // initialise buffer from the arena, returns false when allocation has failed
+    bool init(ekf_arena_t &arena, uint32_t size)
+    {
+        const uint16_t cap = capacity(size);
+        buffer = (element_t *)arena.alloc(cap * sizeof(element_t));
+        if (buffer == nullptr) {
             return false;
         }
-        memset(buffer,0,size*sizeof(element_t));
-        _size = size;
+        _mask = cap - 1;
         _head = 0;
-        _tail = 0;
-        _new_data = false;
+        _count = 0;
         return true;
     }
 
     /*
      * Searches through a ring buffer and return the newest data that is older than the
      * time specified by sample_time_ms
-     * Zeros old data so it cannot not be used again
+     * Discards that data and anything older so it cannot be used again
      * Returns false if no data can be found that is less than 100msec old
     */
 
     bool recall(element_type &element,uint32_t sample_time)
     {
-        if(!_new_data) {
+        if (_count == 0) {
             return false;
         }
-        bool success = false;
-        uint8_t tail = _tail, bestIndex;
-
-        if(_head == tail) {
-            if (buffer[tail].element.time_ms != 0 && buffer[tail].element.time_ms <= sample_time) {
-                // if head is equal to tail just check if the data is unused and within time horizon window
-                if (((sample_time - buffer[tail].element.time_ms) < 100)) {
-                    bestIndex = tail;
-                    success = true;
-                    _new_data = false;
-                }
-            }
-        } else {
-            while(_head != tail) {
-                // find a measurement older than the fusion time horizon that we haven't checked before
-                if (buffer[tail].element.time_ms != 0 && buffer[tail].element.time_ms <= sample_time) {
-                    // Find the most recent non-stale measurement that meets the time horizon criteria
-                    if (((sample_time - buffer[tail].element.time_ms) < 100)) {
-                        bestIndex = tail;
-                        success = true;
-                    }
-                } else if(buffer[tail].element.time_ms > sample_time){
-                    break;
-                }
-                tail = (tail+1)%_size;
+
+        // find the number of unread elements not newer than the fusion time horizon
+        const uint16_t oldest = (_head + 1 + _mask + 1 - _count) & _mask;
+        uint16_t low = 0;
+        uint16_t high = _count;
+        while (low < high) {
+            const uint16_t mid = (low + high) >> 1;
+            if (buffer[(oldest + mid) & _mask].element.time_ms <= sample_time) {
+                low = mid + 1;
+            } else {
+                high = mid;
             }
         }
+        if (low == 0) {
+            // all data is newer than the fusion time horizon
+            return false;
+        }
 
-        if (success) {
-            element = buffer[bestIndex].element;
-            _tail = (bestIndex+1)%_size;
-            //make time zero to stop using it again,
-            //resolves corner case of reusing the element when head == tail
-            buffer[bestIndex].element.time_ms = 0;
-            return true;
-        } else {
+        // the newest candidate and everything older can never be used again
+        const uint16_t bestIndex = (oldest + low - 1) & _mask;
+        _count -= low;
+
+        // reject the most recent candidate if it is stale
+        if ((sample_time - buffer[bestIndex].element.time_ms) >= 100) {
             return false;
         }
+        element = buffer[bestIndex].element;
+        return true;
+    }
+
+    /*
+     * As recall(), for buffers where the timestamps of consecutive pushes
+     * can go backwards, such as range beacons that each have their own
+     * delay. Scans from the oldest unread element and returns the newest
+     * non-stale one before the first that is newer than sample_time_ms.
+     * Discards that data and anything pushed before it
+    */
+    bool recall_unordered(element_type &element, uint32_t sample_time)
+    {
+        const uint16_t oldest = (_head + 1 + _mask + 1 - _count) & _mask;
+        uint16_t used = 0;
+        for (uint16_t i = 0; i < _count; i++) {
+            const uint32_t time_ms = buffer[(oldest + i) & _mask].element.time_ms;
+            if (time_ms > sample_time) {
+                break;
+            }
+            // find the most recent non-stale measurement that meets the time horizon criteria
+            if ((sample_time - time_ms) < 100) {
+                used = i + 1;
+            }
+        }
+        if (used == 0) {
+            return false;
+        }
+        element = buffer[(oldest + used - 1) & _mask].element;
+        _count -= used;
+        return true;
     }
 
     /*
@@ -86,14 +175,16 @@ public:
     inline void push(element_type element)
     {
         // Advance head to next available index
-        _head = (_head+1)%_size;
-        // New data is written at the head
+        _head = (_head+1) & _mask;
+        // New data is written at the head, overwriting the oldest when full
         buffer[_head].element = element;
-        _new_data = true;
+        if (_count <= _mask) {
+            _count++;
+        }
     }
     // writes the same data to all elements in the ring buffer
     inline void reset_history(element_type element, uint32_t sample_time) {
-        for (uint8_t index=0; index<_size; index++) {
+        for (uint16_t index=0; index<=_mask; index++) {
             buffer[index].element = element;
         }
     }
@@ -101,13 +192,12 @@ public:
     // zeroes all data in the ring buffer
     inline void reset() {
         _head = 0;
-        _tail = 0;
-        _new_data = false;
-        memset(buffer,0,_size*sizeof(element_t));
+        _count = 0;
+        memset(buffer,0,(_mask+1)*sizeof(element_t));
     }
 
 private:
-    uint8_t _size,_head,_tail,_new_data;
+    uint16_t _mask,_head,_count;
 };
 
 
@@ -122,15 +212,20 @@ public:
         element_type element;
     } *buffer;
 
-    // initialise buffer, returns false when allocation has failed
-    bool init(uint32_t size)
+    // returns the arena space required for a buffer length
+    static uint32_t storage_size(uint32_t size)
     {
-        buffer = new element_t[size];
+        return ekf_arena_t::aligned_size(size * sizeof(element_t));
+    }
+
+    // initialise buffer from the arena, returns false when allocation has failed
+    bool init(ekf_arena_t &arena, uint32_t size)
+    {
+        buffer = (element_t *)arena.alloc(size * sizeof(element_t));
         if(buffer == nullptr)
         {
             return false;
         }
-        memset(buffer,0,size*sizeof(element_t));
         _size = size;
         _youngest = 0;
         _oldest = 0;
@@ -143,11 +238,14 @@ public:
     inline void push_youngest_element(element_type element)
     {
         // push youngest to the buffer
-        _youngest = (_youngest+1)%_size;
+        if (++_youngest >= _size) {
+            _youngest = 0;
+        }
         buffer[_youngest].element = element;
         // set oldest data index
-        _oldest = (_youngest+1)%_size;
-        if (_oldest == 0) {
+        _oldest = _youngest+1;
+        if (_oldest >= _size) {
+            _oldest = 0;
             _filled = true;
         }
     }
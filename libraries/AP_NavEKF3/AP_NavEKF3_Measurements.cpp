@@ -7,6 +7,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_RangeFinder/RangeFinder_Backend.h>
+#include <AP_NavEKF/AP_NavEKF_IMUFrontend.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -375,8 +376,8 @@ void NavEKF3_core::readIMUData()
     imuDataNew.accel_index = accel_index_active;
     
     // Get delta angle data from primary gyro or primary if not available
-    readDeltaAngle(gyro_index_active, imuDataNew.delAng);
-    imuDataNew.delAngDT = MAX(ins.get_delta_angle_dt(gyro_index_active),1.0e-4f);
+    Quaternion delQuat;
+    readDeltaAngle(gyro_index_active, imuDataNew.delAng, imuDataNew.delAngDT, delQuat);
     imuDataNew.gyro_index = gyro_index_active;
 
     // Get current time stamp
@@ -394,7 +395,7 @@ void NavEKF3_core::readIMUData()
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    imuQuatDownSampleNew *= delQuat;
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
@@ -468,11 +469,11 @@ void NavEKF3_core::readIMUData()
 // read the delta velocity and corresponding time interval from the IMU
 // return false if data is not available
 bool NavEKF3_core::readDeltaVelocity(uint8_t ins_index, Vector3f &dVel, float &dVel_dt) {
-    const AP_InertialSensor &ins = AP::ins();
+    const NavEKF_IMUFrontend::AccelSample *sample = AP::ekf_imu().accel(ins_index);
 
-    if (ins_index < ins.get_accel_count()) {
-        ins.get_delta_velocity(ins_index,dVel);
-        dVel_dt = MAX(ins.get_delta_velocity_dt(ins_index),1.0e-4f);
+    if (sample != nullptr) {
+        dVel = sample->delVel;
+        dVel_dt = MAX(sample->delVelDT,1.0e-4f);
         return true;
     }
     return false;
@@ -617,14 +618,17 @@ void NavEKF3_core::readGpsData()
 
 // read the delta angle and corresponding time interval from the IMU
 // return false if data is not available
-bool NavEKF3_core::readDeltaAngle(uint8_t ins_index, Vector3f &dAng) {
-    const AP_InertialSensor &ins = AP::ins();
+bool NavEKF3_core::readDeltaAngle(uint8_t ins_index, Vector3f &dAng, float &dAng_dt, Quaternion &dQuat) {
+    const NavEKF_IMUFrontend::GyroSample *sample = AP::ekf_imu().gyro(ins_index);
 
-    if (ins_index < ins.get_gyro_count()) {
-        ins.get_delta_angle(ins_index,dAng);
+    if (sample != nullptr) {
+        dAng = sample->delAng;
+        dAng_dt = MAX(sample->delAngDT,1.0e-4f);
+        dQuat = sample->delQuat;
         frontend->logging.log_imu = true;
         return true;
     }
+    dQuat.from_axis_angle(dAng);
     return false;
 }
 
@@ -847,7 +851,8 @@ void NavEKF3_core::readRngBcnData()
     }
 
     // Check the buffer for measurements that have been overtaken by the fusion time horizon and need to be fused
-    rngBcnDataToFuse = storedRangeBeacon.recall(rngBcnDataDelayed, imuDataDelayed.time_ms);
+    // each beacon has its own delay, so the buffered timestamps are not in order
+    rngBcnDataToFuse = storedRangeBeacon.recall_unordered(rngBcnDataDelayed, imuDataDelayed.time_ms);
 
     // Correct the range beacon earth frame origin for estimated offset relative to the EKF earth frame origin
     if (rngBcnDataToFuse) {
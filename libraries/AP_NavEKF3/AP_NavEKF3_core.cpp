@@ -109,39 +109,39 @@ bool NavEKF3_core::setup_core(NavEKF3 *_frontend, uint8_t _imu_index, uint8_t _c
     // limit to be no longer than the IMU buffer (we can't process data faster than the EKF prediction rate)
     obs_buffer_length = MIN(obs_buffer_length,imu_buffer_length);
 
-    if(!storedGPS.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedMag.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedBaro.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedTAS.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedOF.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedBodyOdm.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedWheelOdm.init(imu_buffer_length)) { // initialise to same length of IMU to allow for multiple wheel sensors
-        return false;
-    }
     // Note: the use of dual range finders potentially doubles the amount of data to be stored
-    if(!storedRange.init(MIN(2*obs_buffer_length , imu_buffer_length))) {
+    const uint8_t range_buffer_length = MIN(2*obs_buffer_length , imu_buffer_length);
+
+    // all buffers are carved from a single arena sized for the worst case delays
+    // Note: wheel odometry is sized as the IMU to allow for multiple wheel sensors, and
+    // range beacon data is read one beacon at a time and can arrive at a high rate
+    const uint32_t arena_size =
+        storedGPS.storage_size(obs_buffer_length) +
+        storedMag.storage_size(obs_buffer_length) +
+        storedBaro.storage_size(obs_buffer_length) +
+        storedTAS.storage_size(obs_buffer_length) +
+        storedOF.storage_size(obs_buffer_length) +
+        storedBodyOdm.storage_size(obs_buffer_length) +
+        storedWheelOdm.storage_size(imu_buffer_length) +
+        storedRange.storage_size(range_buffer_length) +
+        storedRangeBeacon.storage_size(imu_buffer_length) +
+        storedIMU.storage_size(imu_buffer_length) +
+        storedOutput.storage_size(imu_buffer_length);
+    if (!buffer_arena.init(arena_size)) {
         return false;
     }
-    // Note: range beacon data is read one beacon at a time and can arrive at a high rate
-    if(!storedRangeBeacon.init(imu_buffer_length)) {
-        return false;
-    }
-    if(!storedIMU.init(imu_buffer_length)) {
-        return false;
-    }
-    if(!storedOutput.init(imu_buffer_length)) {
+
+    if(!storedGPS.init(buffer_arena, obs_buffer_length) ||
+       !storedMag.init(buffer_arena, obs_buffer_length) ||
+       !storedBaro.init(buffer_arena, obs_buffer_length) ||
+       !storedTAS.init(buffer_arena, obs_buffer_length) ||
+       !storedOF.init(buffer_arena, obs_buffer_length) ||
+       !storedBodyOdm.init(buffer_arena, obs_buffer_length) ||
+       !storedWheelOdm.init(buffer_arena, imu_buffer_length) ||
+       !storedRange.init(buffer_arena, range_buffer_length) ||
+       !storedRangeBeacon.init(buffer_arena, imu_buffer_length) ||
+       !storedIMU.init(buffer_arena, imu_buffer_length) ||
+       !storedOutput.init(buffer_arena, imu_buffer_length)) {
         return false;
     }
     gcs().send_text(MAV_SEVERITY_INFO, "EKF3 IMU%u buffers, IMU=%u , OBS=%u , dt=%6.4f",(unsigned)imu_index,(unsigned)imu_buffer_length,(unsigned)obs_buffer_length,(double)dtEkfAvg);
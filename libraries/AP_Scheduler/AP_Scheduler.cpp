@@ -25,6 +25,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <DataFlash/DataFlash.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
+#include <GCS_MAVLink/GCS.h>
 
 #include <stdio.h>
 
@@ -277,15 +278,47 @@ void AP_Scheduler::update_logging()
 {
     if (debug_flags()) {
         perf_info.update_logging();
+        send_bus_stats();
     }
     if (_log_performance_bit != (uint32_t)-1 &&
         DataFlash_Class::instance()->should_log(_log_performance_bit)) {
         Log_Write_Performance();
+        DataFlash_Class::instance()->Log_Write_BusStats();
     }
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
 }
 
+/*
+  report the I2C and SPI transfer statistics to the GCS, giving the
+  share of time each bus address kept its bus busy since the last
+  report
+ */
+void AP_Scheduler::send_bus_stats()
+{
+    const uint32_t now_us = AP_HAL::micros();
+    const uint32_t interval_us = now_us - _bus_stats_report_us;
+    _bus_stats_report_us = now_us;
+
+    const uint8_t n = MIN(AP_HAL::Device::num_bus_stats(), ARRAY_SIZE(_bus_stats_last_busy_us));
+    for (uint8_t i=0; i<n; i++) {
+        const AP_HAL::Device::BusStats *stats = AP_HAL::Device::get_bus_stats(i);
+        if (stats == nullptr) {
+            continue;
+        }
+        const uint64_t busy_us = stats->busy_us - _bus_stats_last_busy_us[i];
+        _bus_stats_last_busy_us[i] = stats->busy_us;
+        gcs().send_text(MAV_SEVERITY_INFO,
+                        "BUS 0x%lx f=%lu max=%lu late=%lu miss=%lu %.1f%%",
+                        (unsigned long)stats->bus_id,
+                        (unsigned long)stats->failures,
+                        (unsigned long)stats->max_us,
+                        (unsigned long)stats->max_late_us,
+                        (unsigned long)stats->missed_deadlines,
+                        (double)(interval_us ? busy_us * 100.0f / interval_us : 0));
+    }
+}
+
 // Write a performance monitoring packet
 void AP_Scheduler::Log_Write_Performance()
 {
@@ -149,6 +149,14 @@ public:
     AP::PerfInfo perf_info;
 
 private:
+    // send I2C and SPI bus statistics to the GCS
+    void send_bus_stats();
+
+    // time of the last bus statistics report, and each bus
+    // address's busy time at that report
+    uint32_t _bus_stats_report_us;
+    uint64_t _bus_stats_last_busy_us[HAL_DEVICE_STATS_MAX];
+
     // function that is called before anything in the scheduler table:
     scheduler_fastloop_fn_t _fastloop_fn;
 
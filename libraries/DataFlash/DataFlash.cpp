@@ -65,6 +65,66 @@ const AP_Param::GroupInfo DataFlash_Class::var_info[] = {
     // @Units: kB
     AP_GROUPINFO("_MAV_BUFSIZE",  5, DataFlash_Class, _params.mav_bufsize,       HAL_DATAFLASH_MAV_BUFSIZE),
 
+    // @Param: _RLIM1_ID
+    // @DisplayName: Rate limited log message 1
+    // @Description: Message type ID, as given in the log's FMT messages, of a message to log at no more than LOG_RLIM1_HZ. Messages written from fast loops can be thinned this way without changing LOG_BITMASK. 0 disables this limit
+    // @Range: 0 255
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM1_ID",  6, DataFlash_Class, _params.rate_limit[0].msg_type,       0),
+
+    // @Param: _RLIM1_HZ
+    // @DisplayName: Rate limit for log message 1
+    // @Description: Maximum rate to log the message selected by LOG_RLIM1_ID. 0 logs every message
+    // @Units: Hz
+    // @Range: 0 400
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM1_HZ",  7, DataFlash_Class, _params.rate_limit[0].rate_hz,       0),
+
+    // @Param: _RLIM2_ID
+    // @DisplayName: Rate limited log message 2
+    // @Description: Message type ID, as given in the log's FMT messages, of a message to log at no more than LOG_RLIM2_HZ. Messages written from fast loops can be thinned this way without changing LOG_BITMASK. 0 disables this limit
+    // @Range: 0 255
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM2_ID",  8, DataFlash_Class, _params.rate_limit[1].msg_type,       0),
+
+    // @Param: _RLIM2_HZ
+    // @DisplayName: Rate limit for log message 2
+    // @Description: Maximum rate to log the message selected by LOG_RLIM2_ID. 0 logs every message
+    // @Units: Hz
+    // @Range: 0 400
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM2_HZ",  9, DataFlash_Class, _params.rate_limit[1].rate_hz,       0),
+
+    // @Param: _RLIM3_ID
+    // @DisplayName: Rate limited log message 3
+    // @Description: Message type ID, as given in the log's FMT messages, of a message to log at no more than LOG_RLIM3_HZ. Messages written from fast loops can be thinned this way without changing LOG_BITMASK. 0 disables this limit
+    // @Range: 0 255
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM3_ID",  10, DataFlash_Class, _params.rate_limit[2].msg_type,       0),
+
+    // @Param: _RLIM3_HZ
+    // @DisplayName: Rate limit for log message 3
+    // @Description: Maximum rate to log the message selected by LOG_RLIM3_ID. 0 logs every message
+    // @Units: Hz
+    // @Range: 0 400
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM3_HZ",  11, DataFlash_Class, _params.rate_limit[2].rate_hz,       0),
+
+    // @Param: _RLIM4_ID
+    // @DisplayName: Rate limited log message 4
+    // @Description: Message type ID, as given in the log's FMT messages, of a message to log at no more than LOG_RLIM4_HZ. Messages written from fast loops can be thinned this way without changing LOG_BITMASK. 0 disables this limit
+    // @Range: 0 255
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM4_ID",  12, DataFlash_Class, _params.rate_limit[3].msg_type,       0),
+
+    // @Param: _RLIM4_HZ
+    // @DisplayName: Rate limit for log message 4
+    // @Description: Maximum rate to log the message selected by LOG_RLIM4_ID. 0 logs every message
+    // @Units: Hz
+    // @Range: 0 400
+    // @User: Advanced
+    AP_GROUPINFO("_RLIM4_HZ",  13, DataFlash_Class, _params.rate_limit[3].rate_hz,       0),
+
     AP_GROUPEND
 };
 
@@ -548,6 +608,18 @@ int16_t DataFlash_Class::get_log_data(uint16_t log_num, uint16_t page, uint32_t
     }
     return backends[0]->get_log_data(log_num, page, offset, len, data);
 }
+bool DataFlash_Class::log_data_ready(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len) {
+    if (_next_backend == 0) {
+        return true;
+    }
+    return backends[0]->log_data_ready(log_num, page, offset, len);
+}
+void DataFlash_Class::end_log_transfer() {
+    if (_next_backend == 0) {
+        return;
+    }
+    backends[0]->end_log_transfer();
+}
 uint16_t DataFlash_Class::get_num_logs(void) {
     if (_next_backend == 0) {
         return 0;
@@ -682,6 +754,18 @@ void DataFlash_Class::Log_WriteV(const char *name, const char *labels, const cha
     }
 }
 
+void DataFlash_Class::Log_Write_Packet(log_write_fmt *f, const uint8_t *pkt, uint8_t len)
+{
+    for (uint8_t i=0; i<_next_backend; i++) {
+        if (!(f->sent_mask & (1U<<i))) {
+            if (!backends[i]->Log_Write_Emit_FMT(f->msg_type)) {
+                continue;
+            }
+            f->sent_mask |= (1U<<i);
+        }
+        backends[i]->WriteBlock(pkt, len);
+    }
+}
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 void DataFlash_Class::assert_same_fmt_for_name(const DataFlash_Class::log_write_fmt *f,
@@ -18,6 +18,7 @@
 #include <AP_RPM/AP_RPM.h>
 #include <AP_RangeFinder/AP_RangeFinder.h>
 #include <DataFlash/LogStructure.h>
+#include <DataFlash/LogFieldTypes.h>
 #include <AP_Motors/AP_Motors.h>
 #include <AP_Rally/AP_Rally.h>
 #include <AP_Beacon/AP_Beacon.h>
@@ -34,6 +35,9 @@
 
 class DataFlash_Backend;
 
+// number of message types that can be rate limited with LOG_RLIMn
+#define DATAFLASH_RATE_LIMITS 4
+
 enum DataFlash_Backend_Type {
     DATAFLASH_BACKEND_NONE = 0,
     DATAFLASH_BACKEND_FILE = 1,
@@ -110,6 +114,7 @@ public:
                         const int16_t y[32],
                         const int16_t z[32]);
     void Log_Write_Vibration();
+    void Log_Write_BusStats();
     void Log_Write_RCIN(void);
     void Log_Write_RCOUT(void);
     void Log_Write_RSSI(AP_RSSI &rssi);
@@ -155,6 +160,43 @@ public:
     void Log_Write(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, ...);
     void Log_WriteV(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, va_list arg_list);
 
+    /*
+      dynamic Log_Write with the format worked out from the argument
+      types at compile time. The packet is built with one copy per
+      field instead of interpreting a format string, and the message
+      type is cached, so this costs about the same as a LogStructure
+      message. Arguments must be fixed width integers, float, double,
+      or char arrays of 4, 16 or 64 bytes, eg:
+        Log_Write_Typed("HTUN", "TimeUS,Coll,RPM", AP_HAL::micros64(), coll, (uint16_t)rpm);
+     */
+    template <typename... Args>
+    void Log_Write_Typed(const char *name, const char *labels, const Args&... args) {
+        static_assert(LOG_PACKET_HEADER_LEN + LogFieldsSize<Args...>::value <= 255, "message too long");
+        static const char fmt[] = { LogFieldType<Args>::code..., 0 };
+
+        // one cached format per argument type list. Call sites with
+        // the same types but other names fall back to the lookup
+        static log_write_fmt *cached;
+        log_write_fmt *f = cached;
+        if (f == nullptr || f->name != name) {
+            f = msg_fmt_for_name(name, labels, nullptr, nullptr, fmt);
+            if (f == nullptr) {
+                internal_error();
+                return;
+            }
+            cached = f;
+        }
+
+        uint8_t pkt[LOG_PACKET_HEADER_LEN + LogFieldsSize<Args...>::value];
+        pkt[0] = HEAD_BYTE1;
+        pkt[1] = HEAD_BYTE2;
+        pkt[2] = f->msg_type;
+        uint8_t *p = &pkt[LOG_PACKET_HEADER_LEN];
+        const int unused[] = { 0, (memcpy(p, &args, sizeof(Args)), p += sizeof(Args), 0)... };
+        (void)unused;
+        Log_Write_Packet(f, pkt, sizeof(pkt));
+    }
+
     // This structure provides information on the internal member data of a PID for logging purposes
     struct PID_Info {
         float desired;
@@ -199,6 +241,10 @@ public:
         AP_Int8 log_disarmed;
         AP_Int8 log_replay;
         AP_Int8 mav_bufsize; // in kilobytes
+        struct {
+            AP_Int16 msg_type;
+            AP_Int16 rate_hz;
+        } rate_limit[DATAFLASH_RATE_LIMITS];
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -267,6 +313,9 @@ private:
     // return (possibly allocating) a log_write_fmt for a name
     struct log_write_fmt *msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt);
 
+    // write a packet built by Log_Write_Typed to all backends
+    void Log_Write_Packet(log_write_fmt *f, const uint8_t *pkt, uint8_t len);
+
     // returns true if msg_type is associated with a message
     bool msg_type_in_use(uint8_t msg_type) const;
 
@@ -363,6 +412,13 @@ private:
     // start page of log data
     uint16_t _log_data_page;
 
+    // download rate measurement, since the log was opened and since
+    // the last report
+    uint32_t _log_data_start_ms;
+    uint32_t _log_data_sent;
+    uint32_t _log_data_report_ms;
+    uint32_t _log_data_report_sent;
+
     GCS_MAVLINK *_log_sending_link;
 
     bool should_handle_log_message();
@@ -379,6 +435,11 @@ private:
     void get_log_info(uint16_t log_num, uint32_t &size, uint32_t &time_utc);
 
     int16_t get_log_data(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len, uint8_t *data);
+    bool log_data_ready(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len);
+    void end_log_transfer();
+
+    // report the download rate to the GCS
+    void log_send_rate_report(bool finished);
 
     /* end support for retrieving logs via mavlink: */
 
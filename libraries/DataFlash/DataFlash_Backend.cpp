@@ -324,9 +324,52 @@ bool DataFlash_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
     if (!WritesOK()) {
         return false;
     }
+    if (!is_critical && rate_limited(pBuffer, size)) {
+        // dropped on purpose, so callers must not retry it
+        return true;
+    }
     return _WritePrioritisedBlock(pBuffer, size, is_critical);
 }
 
+/*
+  decimate message types selected by the LOG_RLIMn parameters. The
+  next allowed time advances by whole intervals so the average rate is
+  kept when the source loop jitters. Writes of the same type shortly
+  after an allowed one are also let through, as messages such as ESC
+  are written once per instance in a single pass
+ */
+#define DATAFLASH_RATE_LIMIT_BURST_US 500
+
+bool DataFlash_Backend::rate_limited(const void *pBuffer, uint16_t size)
+{
+    if (size < LOG_PACKET_HEADER_LEN) {
+        return false;
+    }
+    const uint8_t msg_type = ((const uint8_t *)pBuffer)[2];
+    for (uint8_t i=0; i<DATAFLASH_RATE_LIMITS; i++) {
+        const auto &limit = _front._params.rate_limit[i];
+        if (limit.msg_type != msg_type || limit.rate_hz <= 0) {
+            continue;
+        }
+        const uint32_t now = AP_HAL::micros();
+        if (now - _rate_limit[i].last_us < DATAFLASH_RATE_LIMIT_BURST_US) {
+            return false;
+        }
+        if (_rate_limit[i].next_us != 0 && (int32_t)(now - _rate_limit[i].next_us) < 0) {
+            return true;
+        }
+        const uint32_t interval_us = 1000000UL / limit.rate_hz;
+        _rate_limit[i].next_us += interval_us;
+        if ((int32_t)(now - _rate_limit[i].next_us) >= 0) {
+            // fell behind, or first message
+            _rate_limit[i].next_us = now + interval_us;
+        }
+        _rate_limit[i].last_us = now;
+        return false;
+    }
+    return false;
+}
+
 bool DataFlash_Backend::ShouldLog(bool is_critical)
 {
     if (!_front.WritesEnabled()) {
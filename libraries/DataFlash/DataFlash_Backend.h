@@ -43,6 +43,15 @@ public:
     virtual int16_t get_log_data(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len, uint8_t *data) = 0;
     virtual uint16_t get_num_logs() = 0;
 
+    // return true if get_log_data() can return len bytes from this
+    // position without going to the storage. Backends which read
+    // ahead return false while the data is fetched, and the caller
+    // should try again on a later call
+    virtual bool log_data_ready(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len) { return true; }
+
+    // stop any read ahead started by log_data_ready()
+    virtual void end_log_transfer() { }
+
     virtual bool logging_started(void) const = 0;
 
     virtual void Init() { }
@@ -163,4 +172,13 @@ private:
     uint32_t _last_periodic_1Hz;
     uint32_t _last_periodic_10Hz;
     bool have_logged_armed;
+
+    // return true if a block should be dropped to keep its message
+    // type within the rate set by the LOG_RLIMn parameters
+    bool rate_limited(const void *pBuffer, uint16_t size);
+
+    struct {
+        uint32_t next_us;  // earliest time for the next message
+        uint32_t last_us;  // time the last message was let through
+    } _rate_limit[DATAFLASH_RATE_LIMITS];
 };
@@ -49,6 +49,12 @@ extern const AP_HAL::HAL& hal;
 #define MAX_LOG_FILES 500U
 #define DATAFLASH_PAGE_SIZE 1024UL
 
+// log download read ahead buffer, and the size of each read into it
+#ifndef HAL_DATAFLASH_READ_AHEAD_SIZE
+#define HAL_DATAFLASH_READ_AHEAD_SIZE 16384U
+#endif
+#define DATAFLASH_READ_AHEAD_CHUNK 4096U
+
 /*
   constructor
  */
@@ -60,6 +66,7 @@ DataFlash_File::DataFlash_File(DataFlash_Class &front,
     _read_fd(-1),
     _log_directory(log_directory),
     _writebuf(0),
+    _readbuf(0),
 #if defined(CONFIG_ARCH_BOARD_PX4FMU_V1)
     // V1 gets IO errors with larger than 512 byte writes
     _writebuf_chunk(512),
@@ -85,8 +92,13 @@ DataFlash_File::DataFlash_File(DataFlash_Class &front,
     _perf_write(hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "DF_write")),
     _perf_fsync(hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "DF_fsync")),
     _perf_errors(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_errors")),
-    _perf_overruns(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_overruns"))
+    _perf_overruns(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_overruns")),
+    _perf_read_ahead(hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "DF_read_ahead"))
 {
+    _read_ahead.log_num = 0;
+    _read_ahead.seek_pending = false;
+    _read_ahead.fd = -1;
+    _read_ahead_sem = nullptr;
     df_stats_clear();
 }
 
@@ -108,6 +120,11 @@ void DataFlash_File::Init()
         AP_HAL::panic("Failed to create DataFlash_File write_fd_semaphore");
         return;
     }
+    _read_ahead_sem = hal.util->new_semaphore();
+    if (_read_ahead_sem == nullptr) {
+        AP_HAL::panic("Failed to create DataFlash_File read_ahead_semaphore");
+        return;
+    }
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_PX4 || CONFIG_HAL_BOARD == HAL_BOARD_VRBRAIN
     // try to cope with an existing lowercase log directory
@@ -512,6 +529,7 @@ void DataFlash_File::EraseAll()
 
     const bool was_logging = (_write_fd != -1);
     stop_logging();
+    stop_read_ahead();
 
     for (uint16_t log_num=1; log_num<=MAX_LOG_FILES; log_num++) {
         char *fname = _log_file_name(log_num);
@@ -775,6 +793,28 @@ int16_t DataFlash_File::get_log_data(const uint16_t list_entry, const uint16_t p
     }
     uint32_t ofs = page * (uint32_t)DATAFLASH_PAGE_SIZE + offset;
 
+    // serve from the read ahead buffer if it holds this position
+    if (_read_ahead_sem != nullptr && _read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        int16_t ret = 0;
+        bool served = false;
+        if (_read_ahead.log_num == log_num &&
+            !_read_ahead.seek_pending &&
+            _read_ahead.next_ofs == ofs) {
+            if (_read_ahead.error) {
+                ret = -1;
+                served = true;
+            } else if (_readbuf.available() >= len || _read_ahead.eof) {
+                ret = _readbuf.read(data, len);
+                _read_ahead.next_ofs += ret;
+                served = true;
+            }
+        }
+        _read_ahead_sem->give();
+        if (served) {
+            return ret;
+        }
+    }
+
     /*
       this rather strange bit of code is here to work around a bug
       in file offsets in NuttX. Every few hundred blocks of reads
@@ -815,6 +855,182 @@ int16_t DataFlash_File::get_log_data(const uint16_t list_entry, const uint16_t p
     return ret;
 }
 
+/*
+  check the read ahead buffer holds len bytes from this position,
+  starting read ahead from here if it does not
+ */
+bool DataFlash_File::log_data_ready(const uint16_t list_entry, const uint16_t page, const uint32_t offset, const uint16_t len)
+{
+    if (!_initialised || _open_error) {
+        return true;
+    }
+    if (_readbuf.get_size() == 0) {
+        // allocated on first download, and kept as the IO thread
+        // may still be using it after the download ends
+        if (!_readbuf.set_size(HAL_DATAFLASH_READ_AHEAD_SIZE)) {
+            // read directly from the file instead
+            return true;
+        }
+    }
+    const uint16_t log_num = _log_num_from_list_entry(list_entry);
+    if (log_num == 0) {
+        return true;
+    }
+    const uint32_t ofs = page * (uint32_t)DATAFLASH_PAGE_SIZE + offset;
+    if (_read_ahead_sem == nullptr || !_read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        return true;
+    }
+    bool ready = false;
+    bool new_request = false;
+    if (_read_ahead.seek_pending) {
+        // wait for the IO thread to complete the last request
+    } else if (_read_ahead.log_num != log_num || _read_ahead.next_ofs != ofs) {
+        // new log, or the client is filling a gap. The request is
+        // complete before seek_pending is seen by the IO thread
+        _read_ahead.seek_ofs = ofs;
+        _read_ahead.log_num = log_num;
+        _read_ahead.seek_pending = true;
+        new_request = true;
+    } else {
+        ready = _read_ahead.error || _read_ahead.eof || _readbuf.available() >= len;
+    }
+    _read_ahead_sem->give();
+    if (new_request) {
+        stop_logging();
+    }
+    return ready;
+}
+
+void DataFlash_File::end_log_transfer()
+{
+    stop_read_ahead();
+}
+
+/*
+  stop reading ahead, the IO thread closes the file
+ */
+void DataFlash_File::stop_read_ahead(void)
+{
+    if (_read_ahead_sem == nullptr || !_read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        return;
+    }
+    _read_ahead.log_num = 0;
+    _read_ahead.seek_pending = false;
+    _read_ahead_sem->give();
+}
+
+/*
+  true if the main thread has changed the read ahead request since the
+  IO thread took its copy of it
+ */
+bool DataFlash_File::read_ahead_request_changed(uint16_t log_num)
+{
+    if (!_read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        return true;
+    }
+    const bool changed = _read_ahead.seek_pending || _read_ahead.log_num != log_num;
+    _read_ahead_sem->give();
+    return changed;
+}
+
+/*
+  fill the read ahead buffer, called from the IO thread
+ */
+void DataFlash_File::_io_read_ahead(void)
+{
+    if (_read_ahead_sem == nullptr || !_read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+        return;
+    }
+    // take a consistent copy of the request
+    const uint16_t log_num = _read_ahead.log_num;
+    const uint32_t seek_ofs = _read_ahead.seek_ofs;
+    const bool seek_pending = _read_ahead.seek_pending;
+    _read_ahead_sem->give();
+
+    if (log_num == 0) {
+        if (_read_ahead.fd != -1) {
+            ::close(_read_ahead.fd);
+            _read_ahead.fd = -1;
+        }
+        return;
+    }
+
+    if (seek_pending) {
+        if (_read_ahead.fd != -1 && _read_ahead.fd_log_num != log_num) {
+            ::close(_read_ahead.fd);
+            _read_ahead.fd = -1;
+        }
+        _readbuf.clear();
+        _read_ahead.eof = false;
+        _read_ahead.error = false;
+        if (_read_ahead.fd == -1) {
+            char *fname = _log_file_name(log_num);
+            if (fname != nullptr) {
+                last_io_operation = "read_ahead_open";
+                _read_ahead.fd = ::open(fname, O_RDONLY|O_CLOEXEC);
+                last_io_operation = "";
+                free(fname);
+            }
+            _read_ahead.fd_log_num = log_num;
+        }
+        if (_read_ahead.fd == -1 ||
+            ::lseek(_read_ahead.fd, seek_ofs, SEEK_SET) == (off_t)-1) {
+            _read_ahead.error = true;
+        }
+
+        // complete the request unless it was stopped while seeking
+        if (!_read_ahead_sem->take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+            return;
+        }
+        const bool same_request = _read_ahead.seek_pending &&
+                                  _read_ahead.log_num == log_num &&
+                                  _read_ahead.seek_ofs == seek_ofs;
+        if (same_request) {
+            _read_ahead.next_ofs = seek_ofs;
+            _read_ahead.seek_pending = false;
+        }
+        _read_ahead_sem->give();
+        if (!same_request) {
+            return;
+        }
+    }
+
+    if (_read_ahead.fd == -1 || _read_ahead.eof || _read_ahead.error) {
+        return;
+    }
+
+    hal.util->perf_begin(_perf_read_ahead);
+    last_io_operation = "read_ahead";
+    while (_readbuf.space() >= DATAFLASH_READ_AHEAD_CHUNK &&
+           !read_ahead_request_changed(log_num)) {
+        ByteBuffer::IoVec vec[2];
+        const uint8_t n_vec = _readbuf.reserve(vec, DATAFLASH_READ_AHEAD_CHUNK);
+        uint32_t total = 0;
+        for (uint8_t i=0; i<n_vec; i++) {
+            const ssize_t nread = ::read(_read_ahead.fd, vec[i].data, vec[i].len);
+            if (nread < 0) {
+                _read_ahead.error = true;
+                break;
+            }
+            if (nread == 0) {
+                _read_ahead.eof = true;
+                break;
+            }
+            total += nread;
+            if ((uint32_t)nread < vec[i].len) {
+                // short read, carry on from here next time round
+                break;
+            }
+        }
+        _readbuf.commit(total);
+        if (_read_ahead.eof || _read_ahead.error) {
+            break;
+        }
+    }
+    last_io_operation = "";
+    hal.util->perf_end(_perf_read_ahead);
+}
+
 /*
   find size and date of a log
  */
@@ -905,6 +1121,7 @@ uint16_t DataFlash_File::start_new_log(void)
         ::close(_read_fd);
         _read_fd = -1;
     }
+    stop_read_ahead();
 
     if (disk_space_avail() < _free_space_min_avail) {
         hal.console->printf("Out of space for logging\n");
@@ -1026,6 +1243,9 @@ void DataFlash_File::_io_timer(void)
 {
     uint32_t tnow = AP_HAL::millis();
     _io_timer_heartbeat = tnow;
+    if (_initialised && !_open_error) {
+        _io_read_ahead();
+    }
     if (_write_fd == -1 || !_initialised || _open_error) {
         return;
     }
@@ -39,6 +39,8 @@ public:
     void get_log_boundaries(uint16_t log_num, uint16_t & start_page, uint16_t & end_page) override;
     void get_log_info(uint16_t log_num, uint32_t &size, uint32_t &time_utc) override;
     int16_t get_log_data(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len, uint8_t *data) override;
+    bool log_data_ready(uint16_t log_num, uint16_t page, uint32_t offset, uint16_t len) override;
+    void end_log_transfer() override;
     uint16_t get_num_logs() override;
     uint16_t start_new_log(void) override;
 
@@ -71,6 +73,33 @@ private:
     int _read_fd;
     uint16_t _read_fd_log_num;
     uint32_t _read_offset;
+
+    /*
+      read ahead for log download. The IO thread reads the log in
+      large chunks into _readbuf, so the main thread can send LOG_DATA
+      without touching the filesystem. The main thread requests a log
+      and position through log_num, seek_ofs and seek_pending, and
+      only reads from _readbuf while no seek is pending. log_num,
+      seek_ofs, seek_pending and next_ofs are only accessed holding
+      _read_ahead_sem, which is never held across file IO, so the IO
+      thread always sees a complete request. The fd is only used by
+      the IO thread
+     */
+    struct {
+        uint16_t log_num;           // 0 when not reading ahead
+        uint32_t seek_ofs;
+        bool seek_pending;
+        volatile bool eof;
+        volatile bool error;
+        uint32_t next_ofs;          // file offset of the next byte in _readbuf
+        int fd;
+        uint16_t fd_log_num;
+    } _read_ahead;
+    AP_HAL::Semaphore *_read_ahead_sem;
+    ByteBuffer _readbuf;
+    void _io_read_ahead(void);
+    void stop_read_ahead(void);
+    bool read_ahead_request_changed(uint16_t log_num);
     uint32_t _write_offset;
     volatile bool _open_error;
     const char *_log_directory;
@@ -156,6 +185,7 @@ private:
     AP_HAL::Util::perf_counter_t  _perf_fsync;
     AP_HAL::Util::perf_counter_t  _perf_errors;
     AP_HAL::Util::perf_counter_t  _perf_overruns;
+    AP_HAL::Util::perf_counter_t  _perf_read_ahead;
 
     const char *last_io_operation = "";
 
@@ -102,13 +102,18 @@ struct DataFlash_MAVLink::dm_block *DataFlash_MAVLink::dequeue_seqno(DataFlash_M
     return nullptr;
 }
 
+void DataFlash_MAVLink::free_block(struct dm_block *block)
+{
+    block->next = _blocks_free;
+    _blocks_free = block;
+    _blockcount_free++; // comment me out to expose a bug!
+}
+
 bool DataFlash_MAVLink::free_seqno_from_queue(uint32_t seqno, dm_block_queue_t &queue)
 {
     struct dm_block *block = dequeue_seqno(queue, seqno);
     if (block != nullptr) {
-        block->next = _blocks_free;
-        _blocks_free = block;
-        _blockcount_free++; // comment me out to expose a bug!
+        free_block(block);
         return true;
     }
     return false;
@@ -186,6 +191,8 @@ struct DataFlash_MAVLink::dm_block *DataFlash_MAVLink::next_block()
         _blockcount_free--;
         ret->seqno = _next_seq_num++;
         ret->last_sent = 0;
+        ret->resends = 0;
+        ret->later_acks = 0;
         ret->next = nullptr;
         _latest_block_len = 0;
     }
@@ -203,6 +210,7 @@ void DataFlash_MAVLink::free_all_blocks()
     _blocks_retry.oldest = _blocks_retry.youngest = nullptr;
     _blocks_sent.sent_count = 0;
     _blocks_sent.oldest = _blocks_sent.youngest = nullptr;
+    _blocks_in_flight = 0;
 
     // add blocks to the free stack:
     for(uint8_t i=0; i < _blockcount; i++) {
@@ -219,6 +227,94 @@ void DataFlash_MAVLink::free_all_blocks()
     _latest_block_len = 0;
 }
 
+void DataFlash_MAVLink::window_reset()
+{
+    _window = MIN(DF_MAVLINK_WINDOW_INITIAL, _blockcount);
+    _window_ssthresh = _blockcount;
+    _window_acks = 0;
+    _window_cut_ms = 0;
+    _srtt_ms = 0;
+    _rttvar_ms = 0;
+}
+
+uint32_t DataFlash_MAVLink::resend_timeout_ms() const
+{
+    if (is_zero(_srtt_ms)) {
+        return DF_MAVLINK_RTO_INITIAL_MS;
+    }
+    const float rto = _srtt_ms + 4 * _rttvar_ms;
+    return constrain_float(rto, DF_MAVLINK_RTO_MIN_MS, DF_MAVLINK_RTO_MAX_MS);
+}
+
+/*
+  update the round trip estimate and open the window on an ack. Blocks
+  which have been resent are not timed, as we cannot tell which send
+  the ack is for. Acks are selective, so blocks sent before this one
+  which are still outstanding are counted as passed over, and resent
+  once enough later blocks have got through
+ */
+void DataFlash_MAVLink::block_acked(const struct dm_block &acked, const uint32_t now)
+{
+    if (acked.resends == 0) {
+        const float rtt = now - acked.last_sent;
+        if (is_zero(_srtt_ms)) {
+            _srtt_ms = MAX(rtt, 1.0f);
+            _rttvar_ms = rtt * 0.5f;
+        } else {
+            _rttvar_ms += (fabsf(rtt - _srtt_ms) - _rttvar_ms) * 0.25f;
+            _srtt_ms += (rtt - _srtt_ms) * 0.125f;
+        }
+    }
+
+    if (_window < _window_ssthresh) {
+        _window++;
+    } else if (++_window_acks >= _window) {
+        _window_acks = 0;
+        if (_window < _blockcount) {
+            _window++;
+        }
+    }
+
+    struct dm_block *block = _blocks_sent.oldest;
+    while (block != nullptr) {
+        struct dm_block *next = block->next;
+        if (block->seqno < acked.seqno &&
+            block->last_sent <= acked.last_sent &&
+            ++block->later_acks >= DF_MAVLINK_FAST_RESEND_ACKS) {
+            block = dequeue_seqno(_blocks_sent, block->seqno);
+            if (block != nullptr) {
+                _blocks_in_flight--;
+                requeue_block(block);
+                block_lost(now);
+            }
+        }
+        block = next;
+    }
+}
+
+// close the window after a loss, at most once per round trip as the
+// losses from a single burst are usually reported together
+void DataFlash_MAVLink::block_lost(const uint32_t now)
+{
+    if (_window_cut_ms != 0 && now - _window_cut_ms < _srtt_ms) {
+        return;
+    }
+    _window_cut_ms = now;
+    _window_ssthresh = MAX(_window / 2, DF_MAVLINK_WINDOW_MIN);
+    _window = _window_ssthresh;
+    _window_acks = 0;
+}
+
+// put a block which has been dequeued from the sent queue on the retry queue
+void DataFlash_MAVLink::requeue_block(struct dm_block *block)
+{
+    if (block->resends < UINT8_MAX) {
+        block->resends++;
+    }
+    block->later_acks = 0;
+    enqueue_block(_blocks_retry, block);
+}
+
 void DataFlash_MAVLink::stop_logging()
 {
     if (_sending_to_client) {
@@ -249,6 +345,7 @@ void DataFlash_MAVLink::handle_ack(mavlink_channel_t chan,
             //     return;
             // }
             stats_init();
+            window_reset();
             _sending_to_client = true;
             _target_system_id = msg->sysid;
             _target_component_id = msg->compid;
@@ -262,9 +359,13 @@ void DataFlash_MAVLink::handle_ack(mavlink_channel_t chan,
     }
 
     // check SENT blocks (VERY likely to be first on the list):
-    if (free_seqno_from_queue(seqno, _blocks_sent)) {
+    struct dm_block *block = dequeue_seqno(_blocks_sent, seqno);
+    if (block != nullptr) {
         // celebrate
+        _blocks_in_flight--;
         _last_response_time = AP_HAL::millis();
+        block_acked(*block, _last_response_time);
+        free_block(block);
     } else if(free_seqno_from_queue(seqno, _blocks_retry)) {
         // party
         _last_response_time = AP_HAL::millis();
@@ -297,8 +398,10 @@ void DataFlash_MAVLink::handle_retry(uint32_t seqno)
 
     struct dm_block *victim = dequeue_seqno(_blocks_sent, seqno);
     if (victim != nullptr) {
+        _blocks_in_flight--;
         _last_response_time = AP_HAL::millis();
-        enqueue_block(_blocks_retry, victim);
+        requeue_block(victim);
+        block_lost(_last_response_time);
     }
 }
 
@@ -346,6 +449,7 @@ void DataFlash_MAVLink::Log_Write_DF_MAV(DataFlash_MAVLink &df)
         state_sent_avg    : (uint8_t)(df.stats.state_sent/df.stats.collection_count),
         state_sent_min    : df.stats.state_sent_min,
         state_sent_max    : df.stats.state_sent_max,
+        window            : df._window,
     };
     WriteBlock(&pkt,sizeof(pkt));
 }
@@ -448,6 +552,7 @@ void DataFlash_MAVLink::stats_collect()
 
 /* while we "successfully" send log blocks from a queue, move them to
  * the sent list. DO NOT call this for blocks already sent!
+ * Stops once the window is full.
 */
 bool DataFlash_MAVLink::send_log_blocks_from_queue(dm_block_queue_t &queue)
 {
@@ -456,6 +561,9 @@ bool DataFlash_MAVLink::send_log_blocks_from_queue(dm_block_queue_t &queue)
         if (sent_count++ > _max_blocks_per_send_blocks) {
             return false;
         }
+        if (_blocks_in_flight >= _window) {
+            return false;
+        }
         if (! send_log_block(*queue.oldest)) {
             return false;
         }
@@ -463,6 +571,7 @@ bool DataFlash_MAVLink::send_log_blocks_from_queue(dm_block_queue_t &queue)
         struct DataFlash_MAVLink::dm_block *tmp = dequeue_seqno(queue,queue.oldest->seqno);
         if (tmp != nullptr) { // should never be nullptr
             enqueue_block(_blocks_sent, tmp);
+            _blocks_in_flight++;
         } else {
             internal_error();
         }
@@ -500,28 +609,32 @@ void DataFlash_MAVLink::do_resends(uint32_t now)
         return;
     }
 
-    uint8_t count_to_send = 5;
-    if (_blockcount < count_to_send) {
-        count_to_send = _blockcount;
+    if (!semaphore->take_nonblocking()) {
+        return;
     }
-    uint32_t oldest = now - 100; // 100 milliseconds before resend.  Hmm.
-    while (count_to_send-- > 0) {
-        if (!semaphore->take_nonblocking()) {
-            return;
+    // blocks are resent in place, backing off for each resend so a
+    // link that has gone quiet is not swamped with the same blocks
+    const uint32_t rto = resend_timeout_ms();
+    uint8_t count_to_send = 5;
+    for (struct dm_block *block=_blocks_sent.oldest;
+         block != nullptr && count_to_send > 0;
+         block=block->next) {
+        const uint32_t timeout = rto << MIN(block->resends, 3);
+        if (now - block->last_sent < timeout) {
+            continue;
         }
-        for (struct dm_block *block=_blocks_sent.oldest; block != nullptr; block=block->next) {
-            // only want to send blocks every now-and-then:
-            if (block->last_sent < oldest) {
-                if (! send_log_block(*block)) {
-                    // failed to send the block; try again later....
-                    semaphore->give();
-                    return;
-                }
-                stats.resends++;
-            }
+        if (! send_log_block(*block)) {
+            // failed to send the block; try again later....
+            break;
         }
-        semaphore->give();
+        if (block->resends < UINT8_MAX) {
+            block->resends++;
+        }
+        block_lost(now);
+        stats.resends++;
+        count_to_send--;
     }
+    semaphore->give();
 }
 
 // NOTE: any functions called from these periodic functions MUST
@@ -529,7 +642,6 @@ void DataFlash_MAVLink::do_resends(uint32_t now)
 // appropriately!
 void DataFlash_MAVLink::periodic_10Hz(const uint32_t now)
 {
-    do_resends(now);
     stats_collect();
 }
 void DataFlash_MAVLink::periodic_1Hz(const uint32_t now)
@@ -547,6 +659,9 @@ void DataFlash_MAVLink::periodic_1Hz(const uint32_t now)
 void DataFlash_MAVLink::periodic_fullrate(uint32_t now)
 {
     push_log_blocks();
+    // resend timeouts follow the round trip time, which on a fast
+    // link is well under the 10Hz period
+    do_resends(now);
 }
 
 //TODO: handle full txspace properly
@@ -17,6 +17,23 @@ extern const AP_HAL::HAL& hal;
 
 #define DF_MAVLINK_DISABLE_INTERRUPTS 0
 
+// limits on the number of unacknowledged blocks in flight. The window
+// starts small and opens as acks come back, so a slow telemetry radio
+// is not flooded while a fast UART or UDP link to a companion computer
+// gets enough blocks in flight to cover its round trip
+#define DF_MAVLINK_WINDOW_MIN 4
+#define DF_MAVLINK_WINDOW_INITIAL 8
+
+// a block is presumed lost once this many blocks sent after it have
+// been acked, and is resent without waiting for the timeout
+#define DF_MAVLINK_FAST_RESEND_ACKS 3
+
+// bounds on the resend timeout, which otherwise follows the measured
+// round trip time
+#define DF_MAVLINK_RTO_MIN_MS 20
+#define DF_MAVLINK_RTO_MAX_MS 1000
+#define DF_MAVLINK_RTO_INITIAL_MS 100
+
 class DataFlash_MAVLink : public DataFlash_Backend
 {
 public:
@@ -73,6 +90,8 @@ private:
         uint32_t seqno;
         uint8_t buf[MAVLINK_MSG_REMOTE_LOG_DATA_BLOCK_FIELD_DATA_LEN];
         uint32_t last_sent;
+        uint8_t resends;    // times this block has been sent again
+        uint8_t later_acks; // acks received for blocks sent after this one
         struct dm_block *next;
     };
     bool send_log_block(struct dm_block &block);
@@ -80,6 +99,14 @@ private:
     void handle_retry(uint32_t block_num);
     void do_resends(uint32_t now);
     void free_all_blocks();
+    void free_block(struct dm_block *block);
+
+    // round trip estimation and window sizing
+    void window_reset();
+    void block_acked(const struct dm_block &block, uint32_t now);
+    void block_lost(uint32_t now);
+    void requeue_block(struct dm_block *block);
+    uint32_t resend_timeout_ms() const;
 
     // a stack for free blocks, queues for pending, sent, retries and sent
     struct dm_block_queue {
@@ -97,6 +124,7 @@ private:
     uint8_t queue_size(dm_block_queue_t queue);
     
     struct dm_block *_blocks_free;
+    uint8_t _blocks_in_flight; // length of _blocks_sent
     dm_block_queue_t _blocks_sent;
     dm_block_queue_t _blocks_pending;
     dm_block_queue_t _blocks_retry;
@@ -137,6 +165,20 @@ private:
     // time packing messages in any one loop
     const uint8_t _max_blocks_per_send_blocks;
     
+    // the number of blocks allowed on the sent queue. This grows by
+    // one per ack until _window_ssthresh, then by one per window of
+    // acks, and halves at most once per round trip when blocks are
+    // lost
+    uint8_t _window;
+    uint8_t _window_ssthresh;
+    uint8_t _window_acks;
+    uint32_t _window_cut_ms;
+
+    // smoothed round trip time and its mean deviation, measured from
+    // blocks acked without being resent
+    float _srtt_ms;
+    float _rttvar_ms;
+
     uint32_t _next_seq_num;
     uint16_t _latest_block_len;
     uint32_t _last_response_time;
@@ -133,6 +133,11 @@ void DataFlash_Class::handle_log_request_data(GCS_MAVLINK &link, mavlink_message
 
         uint16_t end;
         get_log_boundaries(packet.id, _log_data_page, end);
+
+        _log_data_start_ms = AP_HAL::millis();
+        _log_data_sent = 0;
+        _log_data_report_ms = _log_data_start_ms;
+        _log_data_report_sent = 0;
     }
 
     _log_data_offset = packet.ofs;
@@ -172,6 +177,7 @@ void DataFlash_Class::handle_log_request_end(GCS_MAVLINK &link, mavlink_message_
 
     transfer_activity = IDLE;
     _log_sending_link = nullptr;
+    end_log_transfer();
 }
 
 /**
@@ -206,11 +212,13 @@ void DataFlash_Class::handle_log_sending()
 #else
     uint8_t num_sends = 1;
     if (_log_sending_link->is_high_bandwidth() && hal.gpio->usb_connected()) {
-        // when on USB we can send a lot more data
-        num_sends = 250;
+        // when on USB we can send a lot more data. The data comes
+        // from the read ahead buffer, so keep going until the
+        // transmit buffer is full
+        num_sends = UINT8_MAX;
     } else if (_log_sending_link->have_flow_control()) {
     #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
-        num_sends = 80;
+        num_sends = UINT8_MAX;
     #else
         num_sends = 10;
     #endif
@@ -226,6 +234,37 @@ void DataFlash_Class::handle_log_sending()
             break;
         }
     }
+
+    if (transfer_activity == SENDING &&
+        AP_HAL::millis() - _log_data_report_ms >= 5000) {
+        log_send_rate_report(false);
+    }
+}
+
+/**
+   send the download rate as text, over the last few seconds while
+   sending and over the whole download when finished
+ */
+void DataFlash_Class::log_send_rate_report(bool finished)
+{
+    const uint32_t now = AP_HAL::millis();
+    uint32_t bytes, dt_ms;
+    if (finished) {
+        bytes = _log_data_sent;
+        dt_ms = now - _log_data_start_ms;
+    } else {
+        bytes = _log_data_sent - _log_data_report_sent;
+        dt_ms = now - _log_data_report_ms;
+    }
+    _log_data_report_ms = now;
+    _log_data_report_sent = _log_data_sent;
+    if (dt_ms == 0 || bytes == 0) {
+        return;
+    }
+    _log_sending_link->send_text(MAV_SEVERITY_INFO, "Log %u %s %lu B/s",
+                                 (unsigned)_log_num_data,
+                                 finished ? "done" : "sending",
+                                 (unsigned long)((uint64_t)bytes * 1000 / dt_ms));
 }
 
 /**
@@ -284,6 +323,10 @@ bool DataFlash_Class::handle_log_send_data()
     if (len > MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
         len = MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
     }
+    if (!log_data_ready(_log_num_data, _log_data_page, _log_data_offset, len)) {
+        // the backend is still fetching this block
+        return false;
+    }
     ret = get_log_data(_log_num_data, _log_data_page, _log_data_offset, len, packet.data);
     if (ret < 0) {
         // report as EOF on error
@@ -305,7 +348,13 @@ bool DataFlash_Class::handle_log_send_data()
 
     _log_data_offset += len;
     _log_data_remaining -= len;
+    _log_data_sent += ret;
     if (ret < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN || _log_data_remaining == 0) {
+        if (ret < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
+            // reached the end of the log, rather than the end of a
+            // request to fill a gap
+            log_send_rate_report(true);
+        }
         transfer_activity = IDLE;
         _log_sending_link = nullptr;
     }
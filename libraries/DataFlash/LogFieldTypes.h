@@ -0,0 +1,66 @@
+/*
+  compile time mapping from C++ types to DataFlash format characters,
+  used by DataFlash_Class::Log_Write_Typed()
+ */
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+template <typename T, typename Enable = void>
+struct LogFieldType {
+    static_assert(sizeof(T) == 0, "type cannot be logged by Log_Write_Typed");
+};
+
+// integers are mapped by size and signedness, as int32_t is long on
+// some targets and int on others
+template <typename T>
+struct LogFieldType<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "unsupported integer size");
+    static const char code =
+        sizeof(T) == 1 ? (std::is_signed<T>::value ? 'b' : 'B') :
+        sizeof(T) == 2 ? (std::is_signed<T>::value ? 'h' : 'H') :
+        sizeof(T) == 4 ? (std::is_signed<T>::value ? 'i' : 'I') :
+                         (std::is_signed<T>::value ? 'q' : 'Q');
+};
+
+template <>
+struct LogFieldType<float> {
+    static const char code = 'f';
+};
+
+template <>
+struct LogFieldType<double> {
+    static const char code = 'd';
+};
+
+// fixed length strings
+template <>
+struct LogFieldType<char[4]> {
+    static const char code = 'n';
+};
+
+template <>
+struct LogFieldType<char[16]> {
+    static const char code = 'N';
+};
+
+template <>
+struct LogFieldType<char[64]> {
+    static const char code = 'Z';
+};
+
+// total packed size of a set of fields
+template <typename... Args>
+struct LogFieldsSize;
+
+template <>
+struct LogFieldsSize<> {
+    static const uint16_t value = 0;
+};
+
+template <typename T, typename... Rest>
+struct LogFieldsSize<T, Rest...> {
+    static const uint16_t value = sizeof(T) + LogFieldsSize<Rest...>::value;
+};
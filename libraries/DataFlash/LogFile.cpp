@@ -407,6 +407,44 @@ void DataFlash_Class::Log_Write_Vibration()
     WriteBlock(&pkt, sizeof(pkt));
 }
 
+/*
+  write the transfer statistics of each I2C and SPI bus address. The
+  counts are totals since boot
+ */
+void DataFlash_Class::Log_Write_BusStats()
+{
+    const uint64_t time_us = AP_HAL::micros64();
+    for (uint8_t i=0; i<AP_HAL::Device::num_bus_stats(); i++) {
+        const AP_HAL::Device::BusStats *stats = AP_HAL::Device::get_bus_stats(i);
+        if (stats == nullptr) {
+            continue;
+        }
+        struct log_BusStats pkt = {
+            LOG_PACKET_HEADER_INIT(LOG_BUS_STATS_MSG),
+            time_us     : time_us,
+            bus_id      : stats->bus_id,
+            transfers   : stats->transfers,
+            failures    : stats->failures,
+            bytes       : stats->bytes,
+            busy_us     : stats->busy_us,
+            max_us      : stats->max_us,
+            max_late_us : stats->max_late_us,
+            missed      : stats->missed_deadlines,
+        };
+        WriteBlock(&pkt, sizeof(pkt));
+
+        // the transfer time histogram does not fit in the BUS message
+        struct log_BusHist hist = {
+            LOG_PACKET_HEADER_INIT(LOG_BUS_HIST_MSG),
+            time_us     : time_us,
+            bus_id      : stats->bus_id,
+        };
+        static_assert(sizeof(hist.hist) == sizeof(stats->hist), "BUSH histogram size");
+        memcpy(hist.hist, stats->hist, sizeof(hist.hist));
+        WriteBlock(&hist, sizeof(hist));
+    }
+}
+
 // Write a mission command. Total length : 36 bytes
 bool DataFlash_Backend::Log_Write_Mission_Cmd(const AP_Mission &mission,
                                               const AP_Mission::Mission_Command &cmd)
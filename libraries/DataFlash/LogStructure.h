@@ -882,6 +882,7 @@ struct PACKED log_DF_MAV_Stats {
     uint8_t state_sent_avg;
     uint8_t state_sent_min;
     uint8_t state_sent_max;
+    uint8_t window;
     // uint8_t state_retry_avg;
     // uint8_t state_retry_min;
     // uint8_t state_retry_max;
@@ -1034,6 +1035,26 @@ struct PACKED log_Performance {
     uint16_t load;
 };
 
+struct PACKED log_BusStats {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t bus_id;
+    uint32_t transfers;
+    uint32_t failures;
+    uint32_t bytes;
+    uint64_t busy_us;
+    uint32_t max_us;
+    uint32_t max_late_us;
+    uint32_t missed;
+};
+
+struct PACKED log_BusHist {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t bus_id;
+    uint32_t hist[8];
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -1241,13 +1262,17 @@ Format characters in the format string for binary log messages
     { LOG_RFND_MSG, sizeof(log_RFND), \
       "RFND", "QCBBCBB", "TimeUS,Dist1,Stat1,Orient1,Dist2,Stat2,Orient2", "sm--m--", "FB--B--" }, \
     { LOG_DF_MAV_STATS, sizeof(log_DF_MAV_Stats), \
-      "DMS", "IIIIIBBBBBBBBBB",         "TimeMS,N,Dp,RT,RS,Er,Fa,Fmn,Fmx,Pa,Pmn,Pmx,Sa,Smn,Smx", "s--------------", "C--------------" }, \
+      "DMS", "IIIIIBBBBBBBBBBB",        "TimeMS,N,Dp,RT,RS,Er,Fa,Fmn,Fmx,Pa,Pmn,Pmx,Sa,Smn,Smx,W", "s---------------", "C---------------" }, \
     { LOG_BEACON_MSG, sizeof(log_Beacon), \
       "BCN", "QBBfffffff",  "TimeUS,Health,Cnt,D0,D1,D2,D3,PosX,PosY,PosZ", "s--mmmmmmm", "F--BBBBBBB" }, \
     { LOG_PROXIMITY_MSG, sizeof(log_Proximity), \
       "PRX", "QBfffffffffff", "TimeUS,Health,D0,D45,D90,D135,D180,D225,D270,D315,DUp,CAn,CDis", "s-mmmmmmmmmhm", "F-BBBBBBBBB00" }, \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHIIH", "TimeUS,NLon,NLoop,MaxT,Mem,Load", "s---b%", "F---0A" }, \
+    { LOG_BUS_STATS_MSG, sizeof(log_BusStats),                          \
+      "BUS", "QIIIIQIII", "TimeUS,Id,Xfr,Fail,Bytes,Busy,MaxT,Late,Miss", "s---bsss-", "F---0FFF-" }, \
+    { LOG_BUS_HIST_MSG, sizeof(log_BusHist),                            \
+      "BUSH", "QIIIIIIIII", "TimeUS,Id,H0,H1,H2,H3,H4,H5,H6,H7", "s---------", "F---------" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }
 
@@ -1560,6 +1585,8 @@ enum LogMessages : uint8_t {
     LOG_ISBD_MSG,
     LOG_ASP2_MSG,
     LOG_PERFORMANCE_MSG,
+    LOG_BUS_STATS_MSG,
+    LOG_BUS_HIST_MSG,
     _LOG_LAST_MSG_
 };
 
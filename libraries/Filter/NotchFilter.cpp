@@ -135,6 +135,30 @@ Vector3f NotchFilterVector3fParam::apply(const Vector3f &sample)
     return filter.apply(sample);
 }
 
+/*
+  apply a filter sample from another stream, using the state in s
+ */
+Vector3f NotchFilterVector3fParam::apply(stream &s, float _sample_freq_hz, const Vector3f &sample) const
+{
+    if (!enable || !is_positive(_sample_freq_hz)) {
+        return sample;
+    }
+
+    // check for changed sample rate or parameters
+    if (!is_equal(_sample_freq_hz, s.sample_freq_hz) ||
+        !is_equal(center_freq_hz.get(), s.center_freq_hz) ||
+        !is_equal(bandwidth_hz.get(), s.bandwidth_hz) ||
+        !is_equal(attenuation_dB.get(), s.attenuation_dB)) {
+        s.filter.init(_sample_freq_hz, center_freq_hz, bandwidth_hz, attenuation_dB);
+        s.sample_freq_hz = _sample_freq_hz;
+        s.center_freq_hz = center_freq_hz;
+        s.bandwidth_hz = bandwidth_hz;
+        s.attenuation_dB = attenuation_dB;
+    }
+
+    return s.filter.apply(sample);
+}
+
 /* 
    instantiate template classes
  */
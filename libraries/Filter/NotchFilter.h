@@ -48,6 +48,17 @@ public:
     void init(float sample_freq_hz);
     Vector3f apply(const Vector3f &sample);
 
+    // filter state for another stream of samples, possibly at another
+    // sample rate, filtered with the same parameters
+    struct stream {
+        float sample_freq_hz;
+        float center_freq_hz;
+        float bandwidth_hz;
+        float attenuation_dB;
+        NotchFilter<Vector3f> filter;
+    };
+    Vector3f apply(stream &s, float sample_freq_hz, const Vector3f &sample) const;
+
     static const struct AP_Param::GroupInfo var_info[];
     
 private:
@@ -898,11 +898,21 @@ GCS_MAVLINK::update(uint32_t max_time_us)
 
     status.packet_rx_drop_count = 0;
 
-    // process received bytes
+    // process received bytes, reading them from the port in chunks
+    uint8_t rx_buf[64];
+    uint16_t rx_len = 0;
+    uint16_t rx_ofs = 0;
     uint16_t nbytes = comm_get_available(chan);
     for (uint16_t i=0; i<nbytes; i++)
     {
-        const uint8_t c = (uint8_t)_port->read();
+        if (rx_ofs == rx_len) {
+            rx_len = _port->read(rx_buf, MIN((uint16_t)(nbytes - i), sizeof(rx_buf)));
+            rx_ofs = 0;
+            if (rx_len == 0) {
+                break;
+            }
+        }
+        const uint8_t c = rx_buf[rx_ofs++];
         const uint32_t protocol_timeout = 4000;
         
         if (alternative.handler &&
@@ -926,20 +936,19 @@ GCS_MAVLINK::update(uint32_t max_time_us)
             }
         }
 
-        bool parsed_packet = false;
-
         // Try to get a new message
         if (mavlink_parse_char(chan, c, &msg, &status)) {
             hal.util->perf_begin(_perf_packet);
             packetReceived(status, msg);
             hal.util->perf_end(_perf_packet);
-            parsed_packet = true;
             gcs_alternative_active[chan] = false;
             alternative.last_mavlink_ms = now_ms;
         }
 
-        if (parsed_packet || i % 100 == 0) {
-            // make sure we don't spend too much time parsing mavlink messages
+        // make sure we don't spend too much time parsing mavlink
+        // messages. This is checked once each chunk has been parsed
+        // so no bytes read from the port are lost
+        if (rx_ofs == rx_len) {
             if (AP_HAL::micros() - tstart_us > max_time_us) {
                 break;
             }
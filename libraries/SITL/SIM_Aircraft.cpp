@@ -188,11 +188,11 @@ void Aircraft::update_position(void)
 #if 0
     // logging of raw sitl data
     Vector3f accel_ef = dcm * accel_body;
-    DataFlash_Class::instance()->Log_Write("SITL", "TimeUS,VN,VE,VD,AN,AE,AD,PN,PE,PD", "Qfffffffff",
-                                           AP_HAL::micros64(),
-                                           velocity_ef.x, velocity_ef.y, velocity_ef.z,
-                                           accel_ef.x, accel_ef.y, accel_ef.z,
-                                           position.x, position.y, position.z);
+    DataFlash_Class::instance()->Log_Write_Typed("SITL", "TimeUS,VN,VE,VD,AN,AE,AD,PN,PE,PD",
+                                                 AP_HAL::micros64(),
+                                                 velocity_ef.x, velocity_ef.y, velocity_ef.z,
+                                                 accel_ef.x, accel_ef.y, accel_ef.z,
+                                                 position.x, position.y, position.z);
 #endif
 }
 
@@ -165,7 +165,44 @@ void FlightAxis::parse_reply(const char *reply)
 
 
 /*
-  make a SOAP request, returning body of reply
+  open the connection to FlightAxis if it is not already open
+ */
+bool FlightAxis::open_socket(void)
+{
+    if (sock != nullptr) {
+        return true;
+    }
+    sock = new SocketAPM(false);
+    if (sock == nullptr) {
+        return false;
+    }
+    if (!sock->connect(controller_ip, controller_port)) {
+        delete sock;
+        sock = nullptr;
+        return false;
+    }
+    sock->set_blocking(false);
+    socket_io.add(*sock);
+    return true;
+}
+
+/*
+  drop the connection to FlightAxis, it is re-opened on the next request
+ */
+void FlightAxis::close_socket(void)
+{
+    if (sock == nullptr) {
+        return;
+    }
+    socket_io.remove(*sock);
+    delete sock;
+    sock = nullptr;
+}
+
+/*
+  make a SOAP request, returning body of reply. The connection is kept
+  open between requests so each frame costs one round trip rather
+  than a TCP connect and teardown
  */
 char *FlightAxis::soap_request(const char *action, const char *fmt, ...)
 {
@@ -179,12 +216,10 @@ char *FlightAxis::soap_request(const char *action, const char *fmt, ...)
     //printf("%s\n", req1);
 
     // open SOAP socket to FlightAxis
-    SocketAPM sock(false);
-    if (!sock.connect(controller_ip, controller_port)) {
+    if (!open_socket()) {
         free(req1);
         return nullptr;
     }
-    sock.set_blocking(false);
 
     char *req;
     asprintf(&req, R"(POST / HTTP/1.1
@@ -196,19 +231,30 @@ Connection: Keep-Alive
 %s)",
              action,
              (unsigned)strlen(req1), req1);
-    sock.send(req, strlen(req));
+    const ssize_t req_len = strlen(req);
+    const ssize_t sent = sock->send(req, req_len);
     free(req1);
     free(req);
+    if (sent != req_len) {
+        // the connection has been closed, retry on the next request
+        close_socket();
+        return nullptr;
+    }
     char reply[10000];
     memset(reply, 0, sizeof(reply));
-    ssize_t ret = sock.recv(reply, sizeof(reply)-1, 1000);
+    ssize_t ret = -1;
+    if (socket_io.wait(1000)) {
+        ret = sock->recv(reply, sizeof(reply)-1, 0);
+    }
     if (ret <= 0) {
         printf("No data\n");
+        close_socket();
         return nullptr;
     }
     char *p = strstr(reply, "Content-Length: ");
     if (p == nullptr) {
         printf("No Content-Length\n");
+        close_socket();
         return nullptr;
     }
 
@@ -217,6 +263,7 @@ Connection: Keep-Alive
     char *body = strstr(p, "\r\n\r\n");
     if (body == nullptr) {
         printf("No body\n");
+        close_socket();
         return nullptr;
     }
     body += 4;
@@ -225,17 +272,27 @@ Connection: Keep-Alive
     int32_t expected_length = content_length + (body - reply);
     if (expected_length >= (int32_t)sizeof(reply)) {
         printf("Reply too large %i\n", expected_length);
+        close_socket();
         return nullptr;
     }
     while (ret < expected_length) {
-        ssize_t ret2 = sock.recv(&reply[ret], sizeof(reply)-(1+ret), 100);
+        ssize_t ret2 = -1;
+        if (socket_io.wait(100)) {
+            ret2 = sock->recv(&reply[ret], sizeof(reply)-(1+ret), 0);
+        }
         if (ret2 <= 0) {
+            close_socket();
             return nullptr;
         }
         // nul terminate
         reply[ret+ret2] = 0;
         ret += ret2;
     }
+    if (strstr(reply, "Connection: close") != nullptr ||
+        strstr(reply, "connection: close") != nullptr) {
+        // FlightAxis does not want to keep the connection open
+        close_socket();
+    }
     return strdup(reply);
 }
 
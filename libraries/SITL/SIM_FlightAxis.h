@@ -21,6 +21,7 @@
 #include <AP_HAL/utility/Socket.h>
 
 #include "SIM_Aircraft.h"
+#include "SIM_SocketIO.h"
 
 namespace SITL {
 
@@ -153,6 +154,8 @@ public:
 
 private:
     char *soap_request(const char *action, const char *fmt, ...);
+    bool open_socket(void);
+    void close_socket(void);
     void exchange_data(const struct sitl_input &input);
     void parse_reply(const char *reply);
 
@@ -180,6 +183,10 @@ private:
     const char *controller_ip = "127.0.0.1";
     uint16_t controller_port = 18083;
 
+    // keep-alive connection to FlightAxis, reused for every request
+    SocketAPM *sock = nullptr;
+    SocketIO socket_io;
+
     pthread_t thread;
     AP_HAL::Semaphore *mutex;
 };
@@ -51,6 +51,7 @@ void Gazebo::set_interface_ports(const char* address, const int port_in, const i
     printf("Bind %s:%d for SITL in\n", "127.0.0.1", port_in);
     socket_sitl.reuseaddress();
     socket_sitl.set_blocking(false);
+    socket_io.add(socket_sitl);
 
     _gazebo_address = address;
     _gazebo_port = port_out;
@@ -82,9 +83,12 @@ void Gazebo::recv_fdm(const struct sitl_input &input)
 
     /*
       we re-send the servo packet every 0.1 seconds until we get a
-      reply. This allows us to cope with some packet loss to the FDM
+      reply. This allows us to cope with some packet loss to the FDM.
+      Any backlog is consumed with the reply, keeping only the newest
+      packet, so we never fall behind Gazebo
      */
-    while (socket_sitl.recv(&pkt, sizeof(pkt), 100) != sizeof(pkt)) {
+    while (!socket_io.wait(100) ||
+           !SocketIO::recv_latest(socket_sitl, &pkt, sizeof(pkt))) {
         send_servos(input);
         // Reset the timestamp after a long disconnection, also catch gazebo reset
         if (get_wall_time_us() > last_wall_time_us + GAZEBO_TIMEOUT_US) {
@@ -132,29 +136,6 @@ void Gazebo::recv_fdm(const struct sitl_input &input)
 
 }
 
-/*
-  Drain remaining data on the socket to prevent phase lag.
- */
-void Gazebo::drain_sockets()
-{
-    const uint16_t buflen = 1024;
-    char buf[buflen];
-    ssize_t received;
-    errno = 0;
-    do {
-        received = socket_sitl.recv(buf, buflen, 0);
-        if (received < 0) {
-            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != 0) {
-                fprintf(stderr, "error recv on socket in: %s \n",
-                        strerror(errno));
-            }
-        } else {
-            // fprintf(stderr, "received from control socket: %s\n", buf);
-        }
-    } while (received > 0);
-
-}
-
 /*
   update the Gazebo simulation by one time step
  */
@@ -167,7 +148,9 @@ void Gazebo::update(const struct sitl_input &input)
     time_advance();
     // update magnetic field
     update_mag_field_bf();
-    drain_sockets();
+
+    // drop any late replies to re-sent servo packets to prevent phase lag
+    SocketIO::drain(socket_sitl);
 }
 
 }  // namespace SITL
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "SIM_Aircraft.h"
+#include "SIM_SocketIO.h"
 #include <AP_HAL/utility/Socket.h>
 
 namespace SITL {
@@ -64,11 +65,11 @@ private:
 
     void recv_fdm(const struct sitl_input &input);
     void send_servos(const struct sitl_input &input);
-    void drain_sockets();
 
     double last_timestamp;
 
     SocketAPM socket_sitl;
+    SocketIO socket_io;
     const char *_gazebo_address = "127.0.0.1";
     int _gazebo_port = 9002;
     static const uint64_t GAZEBO_TIMEOUT_US = 5000000;
@@ -46,6 +46,11 @@ Helicopter::Helicopter(const char *home_str, const char *frame_str) :
         frame_type = HELI_FRAME_CONVENTIONAL;
     }
     gas_heli = (strstr(frame_str, "-gas") != nullptr);
+    twin_engine = (strstr(frame_str, "-twin") != nullptr);
+    bem = (strstr(frame_str, "-bem") != nullptr) && frame_type == HELI_FRAME_CONVENTIONAL;
+    if (bem) {
+        mass = 3.5f;
+    }
 
     ground_behavior = GROUND_BEHAVIOR_NO_MOVEMENT;
 }
@@ -55,6 +60,11 @@ Helicopter::Helicopter(const char *home_str, const char *frame_str) :
  */
 void Helicopter::update(const struct sitl_input &input)
 {
+    if (bem) {
+        update_bem(input);
+        return;
+    }
+
     // get wind vector setup
     update_wind(input);
 
@@ -170,4 +180,102 @@ void Helicopter::update(const struct sitl_input &input)
     update_mag_field_bf();
 }
 
+/*
+  torque at the rotor from one gas engine, through a one way clutch. The
+  torque curve peaks a little above the reference rotor speed
+ */
+float Helicopter::engine_torque(float throttle) const
+{
+    const float peak_speed = rotor.params.reference_speed * 1.1f;
+    const float curve = 1 - 0.3f * sq(rotor_speed / peak_speed - 1);
+    const float max_torque = twin_engine ? engine_max_torque * 0.5f : engine_max_torque;
+    const float open = engine_idle + (1 - engine_idle) * throttle;
+    return MAX(max_torque * open * curve, 0.0f);
+}
+
+/*
+  update the helicopter using the blade element rotor model. The rotor
+  speed is a state driven by engine torque against rotor and tail
+  drag, so RSC ramps, governors and throttle curves see realistic
+  rotor speed and torque response
+ */
+void Helicopter::update_bem(const struct sitl_input &input)
+{
+    // get wind vector setup
+    update_wind(input);
+
+    const float delta_time = frame_time_us * 1.0e-6f;
+
+    const float swash1 = (input.servos[0]-1000) / 1000.0f;
+    const float swash2 = (input.servos[1]-1000) / 1000.0f;
+    const float swash3 = (input.servos[2]-1000) / 1000.0f;
+    const float tail_rotor = (input.servos[3]-1000) / 1000.0f;
+
+    // H3-120 swashplate mixing back to blade pitch
+    const float collective = ((swash1+swash2+swash3) / 3.0f - 0.5f) * 2 * collective_range;
+    const float cyclic_lat = (swash1 - swash2) * cyclic_range;
+    const float cyclic_lon = ((swash1+swash2) / 2.0f - swash3) * cyclic_range;
+
+    // engine or ESC torque. Throttle is on channel 8, with the second
+    // engine of a twin on channel 7
+    const float throttle = constrain_float((input.servos[7]-1000) / 1000.0f, 0, 1);
+    float drive_torque = 0;
+    if (!gas_heli) {
+        drive_torque = MAX(esc_stall_torque * (throttle - rotor_speed / esc_free_speed), 0.0f);
+    } else if (input.servos[5] > 1500) {
+        // ignition on
+        drive_torque = engine_torque(throttle);
+        if (twin_engine) {
+            const float throttle2 = constrain_float((input.servos[6]-1000) / 1000.0f, 0, 1);
+            drive_torque += engine_torque(throttle2);
+        }
+    }
+
+    rotor.update(delta_time, rotor_speed, collective, cyclic_lon, cyclic_lat, velocity_air_bf, gyro);
+
+    // tail rotor, geared to the main rotor
+    const float tail_speed_ratio = rotor_speed / rotor.params.reference_speed;
+    const float tail_thrust = (tail_rotor - 0.5f) * 2 * tail_thrust_max * sq(tail_speed_ratio) -
+        tail_yaw_damping * gyro.z * tail_speed_ratio;
+    const float tail_power = powf(fabsf(tail_thrust), 1.5f) / sqrtf(2 * SSL_AIR_DENSITY * tail_disc_area);
+    const float tail_torque = tail_power / MAX(rotor_speed, 1.0f);
+
+    // rotor speed. Friction is only applied while turning
+    const float friction = rotor_speed > 0 ? rotor_friction : 0;
+    const float net_torque = drive_torque - rotor.get_torque() - tail_torque - friction;
+    rotor_speed = MAX(rotor_speed + net_torque / rotor_inertia * delta_time, 0.0f);
+
+    // the engine reacts against the airframe, turning it against the
+    // counter-clockwise rotor
+    Vector3f moment = rotor.get_moment();
+    moment.z += drive_torque - friction + tail_thrust * tail_arm;
+
+    // fuselage drag
+    const Vector3f &v = velocity_air_bf;
+    const Vector3f drag(-0.5f * SSL_AIR_DENSITY * fuselage_cda.x * v.x * fabsf(v.x),
+                        -0.5f * SSL_AIR_DENSITY * fuselage_cda.y * v.y * fabsf(v.y),
+                        -0.5f * SSL_AIR_DENSITY * fuselage_cda.z * v.z * fabsf(v.z));
+
+    Vector3f force = rotor.get_force() + drag;
+    force.y -= tail_thrust;
+
+    accel_body = force / mass;
+
+    // rotational acceleration, in rad/s/s, in body frame
+    const Vector3f rot_accel(moment.x / bem_inertia.x,
+                             moment.y / bem_inertia.y,
+                             moment.z / bem_inertia.z);
+
+    rpm1 = rotor_speed * 60 / M_2PI;
+
+    update_dynamics(rot_accel);
+
+    // update lat/lon/altitude
+    update_position();
+    time_advance();
+
+    // update magnetic field
+    update_mag_field_bf();
+}
+
 } // namespace SITL
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "SIM_Aircraft.h"
+#include "SIM_RotorDisc.h"
 
 namespace SITL {
 
@@ -56,6 +57,30 @@ private:
         HELI_FRAME_COMPOUND
     } frame_type = HELI_FRAME_CONVENTIONAL;
     bool gas_heli = false;
+
+    // blade element model, selected with the -bem frame option
+    bool bem = false;
+    // second engine driven by the aux throttle channel, -twin option
+    bool twin_engine = false;
+    RotorDisc rotor;
+    float rotor_speed = 0;                          // rad/s
+    Vector3f bem_inertia { 0.08f, 0.18f, 0.16f };   // kg m^2
+    Vector3f fuselage_cda { 0.04f, 0.12f, 0.20f };  // drag area, m^2
+    float collective_range = radians(16);           // blade pitch for full swash travel from centre
+    float cyclic_range = radians(8);
+    float rotor_inertia = 0.06f;                    // including head and gearing, kg m^2
+    float rotor_friction = 0.05f;                   // Nm
+    float esc_free_speed = 210;                     // rotor speed at full throttle and no load, rad/s
+    float esc_stall_torque = 40;                    // Nm at the rotor
+    float engine_max_torque = 4;                    // Nm at the rotor, split between engines if twin
+    float engine_idle = 0.08f;                      // throttle fraction at zero input
+    float tail_thrust_max = 8;                      // N at reference rotor speed
+    float tail_arm = 0.85f;                         // m
+    float tail_disc_area = 0.05f;                   // m^2
+    float tail_yaw_damping = 0.3f;                  // N per rad/s
+
+    void update_bem(const struct sitl_input &input);
+    float engine_torque(float throttle) const;
 };
 
 } // namespace SITL
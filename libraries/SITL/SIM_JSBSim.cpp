@@ -286,6 +286,7 @@ bool JSBSim::open_control_socket(void)
     }
     printf("Opened JSBSim control socket\n");
     sock_control.set_blocking(false);
+    socket_io.add(sock_control);
     opened_control_socket = true;
 
     char startup[] =
@@ -311,6 +312,7 @@ bool JSBSim::open_fdm_socket(void)
     }
     sock_fgfdm.set_blocking(false);
     sock_fgfdm.reuseaddress();
+    socket_io.add(sock_fgfdm);
     opened_fdm_socket = true;
     return true;
 }
@@ -400,9 +402,26 @@ void JSBSim::recv_fdm(const struct sitl_input &input)
 {
     FGNetFDM fdm;
     check_stdout();
-    while (sock_fgfdm.recv(&fdm, sizeof(fdm), 100) != sizeof(fdm)) {
-        send_servos(input);
-        check_stdout();
+    /*
+      wait on the control and fdm sockets together, so command replies
+      from JSBSim are consumed as they arrive instead of filling the
+      control socket while we wait for the next fdm packet
+     */
+    while (true) {
+        if (!socket_io.wait(100)) {
+            send_servos(input);
+            check_stdout();
+            continue;
+        }
+        if (socket_io.readable(sock_control) &&
+            !SocketIO::drain(sock_control)) {
+            fprintf(stderr, "Fatal: JSBSim closed control socket\n");
+            exit(1);
+        }
+        if (socket_io.readable(sock_fgfdm) &&
+            SocketIO::recv_latest(sock_fgfdm, &fdm, sizeof(fdm))) {
+            break;
+        }
     }
     fdm.ByteSwap();
 
@@ -432,23 +451,6 @@ void JSBSim::recv_fdm(const struct sitl_input &input)
     time_now_us += 1000;
 }
 
-void JSBSim::drain_control_socket()
-{
-    const uint16_t buflen = 1024;
-    char buf[buflen];
-    ssize_t received;
-    do {
-        received = sock_control.recv(buf, buflen, 0);
-        if (received < 0) {
-            if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                fprintf(stderr, "error recv on control socket: %s",
-                        strerror(errno));
-            }
-        } else {
-            // fprintf(stderr, "received from control socket: %s\n", buf);
-        }
-    } while (received > 0);
-}
 /*
   update the JSBSim simulation by one time step
  */
@@ -468,7 +470,7 @@ void JSBSim::update(const struct sitl_input &input)
     recv_fdm(input);
     adjust_frame_time(1000);
     sync_frame_time();
-    drain_control_socket();
+    SocketIO::drain(sock_control);
 }
 
 } // namespace SITL
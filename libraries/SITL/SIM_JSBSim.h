@@ -21,6 +21,7 @@
 #include <AP_HAL/utility/Socket.h>
 
 #include "SIM_Aircraft.h"
+#include "SIM_SocketIO.h"
 
 namespace SITL {
 
@@ -46,6 +47,9 @@ private:
     // UDP packets from JSBSim in fgFDM format
     SocketAPM sock_fgfdm;
 
+    // waits on both sockets at once
+    SocketIO socket_io;
+
     bool initialised;
 
     uint16_t control_port;
@@ -76,8 +80,6 @@ private:
     void recv_fdm(const struct sitl_input &input);
     void check_stdout(void);
     bool expect(const char *str);
-
-    void drain_control_socket();
 };
 
 /*
@@ -0,0 +1,163 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  blade element model of a helicopter main rotor
+*/
+
+#include "SIM_RotorDisc.h"
+
+namespace SITL {
+
+// time constant for the induced velocity to follow thrust changes
+static const float inflow_time_constant = 0.05f;
+
+// limit on disc tilt, representing the flapping stops
+static const float tpp_limit = radians(15);
+
+RotorDisc::RotorDisc() :
+    inflow(0),
+    tpp_lon(0),
+    tpp_lat(0),
+    thrust(0),
+    torque(0)
+{
+    init();
+}
+
+/*
+  precompute the per station values. Stations are spaced evenly from
+  the root cutout to the tip and sit at the middle of their strip
+ */
+void RotorDisc::init(void)
+{
+    const float span = params.radius - params.root_cutout;
+    const float dr = span / ROTOR_DISC_STATIONS;
+    for (uint8_t i=0; i<ROTOR_DISC_STATIONS; i++) {
+        const float r = params.root_cutout + (i + 0.5f) * dr;
+        station_r[i] = r;
+        station_cdr[i] = params.chord * dr;
+        station_crdr[i] = params.chord * r * dr;
+        station_twist[i] = params.twist * (r - params.root_cutout) / span;
+    }
+    for (uint8_t k=0; k<ROTOR_DISC_AZIMUTHS; k++) {
+        sin_azimuth[k] = sinf(k * M_2PI / ROTOR_DISC_AZIMUTHS);
+    }
+    disc_area = M_PI * sq(params.radius);
+    lock_number = SSL_AIR_DENSITY * params.lift_slope * params.chord *
+        powf(params.radius, 4) / params.blade_inertia;
+}
+
+/*
+  sum blade element thrust and torque over the disc. Small angle
+  aerodynamics keep the inner loop free of trig so it vectorises over
+  stations. Elements in reverse flow on the retreating side are ignored
+ */
+void RotorDisc::integrate_elements(float omega, float theta0, float v_inplane, float v_perp)
+{
+    const float a = params.lift_slope;
+    const float stall = params.stall_aoa;
+    const float cd0 = params.cd0;
+    const float cd2 = params.cd2;
+
+    float ut_offset[ROTOR_DISC_AZIMUTHS];
+    for (uint8_t k=0; k<ROTOR_DISC_AZIMUTHS; k++) {
+        ut_offset[k] = v_inplane * sin_azimuth[k];
+    }
+
+    // accumulate per station so the sums do not need reassociating
+    // to vectorise, then reduce once at the end
+    float t_acc[ROTOR_DISC_STATIONS];
+    float q_acc[ROTOR_DISC_STATIONS];
+    for (uint8_t i=0; i<ROTOR_DISC_STATIONS; i++) {
+        float t = 0;
+        float q = 0;
+        for (uint8_t k=0; k<ROTOR_DISC_AZIMUTHS; k++) {
+            // limits are written with fabsf rather than compares, which
+            // would stop the loop vectorising without -fno-trapping-math
+            const float ut_raw = omega * station_r[i] + ut_offset[k];
+            const float ut = 0.5f * (ut_raw + fabsf(ut_raw));
+            const float phi = v_perp / (1 + 0.5f * (ut - 1 + fabsf(ut - 1)));
+            const float aoa = theta0 + station_twist[i] - phi;
+            const float alpha = 0.5f * (fabsf(aoa + stall) - fabsf(aoa - stall));
+            const float cl = a * alpha;
+            const float cd = cd0 + cd2 * alpha * alpha;
+            const float ut2 = ut * ut;
+            t += ut2 * (cl - cd * phi);
+            q += ut2 * (cl * phi + cd);
+        }
+        t_acc[i] = t * station_cdr[i];
+        q_acc[i] = q * station_crdr[i];
+    }
+    float t_sum = 0;
+    float q_sum = 0;
+    for (uint8_t i=0; i<ROTOR_DISC_STATIONS; i++) {
+        t_sum += t_acc[i];
+        q_sum += q_acc[i];
+    }
+
+    const float scale = 0.5f * SSL_AIR_DENSITY * params.blades / ROTOR_DISC_AZIMUTHS;
+    thrust = t_sum * scale;
+    torque = q_sum * scale;
+}
+
+/*
+  advance the rotor by one time step
+ */
+void RotorDisc::update(float dt, float omega, float collective,
+                       float cyclic_lon, float cyclic_lat,
+                       const Vector3f &velocity_air_bf, const Vector3f &gyro)
+{
+    omega = MAX(omega, 0.0f);
+
+    // air velocity in the disc plane, and down through the disc
+    const float v_inplane = norm(velocity_air_bf.x, velocity_air_bf.y);
+    const float v_climb = -velocity_air_bf.z;
+
+    integrate_elements(omega, collective, v_inplane, inflow + v_climb);
+
+    // momentum theory with Glauert's forward flight correction. The
+    // inflow lags the thrust, which also keeps the fixed point stable
+    const float v_total = MAX(norm(v_inplane, inflow + v_climb), 0.5f);
+    const float inflow_target = MAX(thrust, 0.0f) / (2 * SSL_AIR_DENSITY * disc_area * v_total);
+    inflow += (inflow_target - inflow) * MIN(dt / inflow_time_constant, 1.0f);
+
+    /*
+      first order tip path plane dynamics. The disc lags body rotation
+      by the flapping time constant, which is where the rotor damping
+      comes from, and blows back away from the relative wind
+     */
+    const float tip_speed = MAX(omega * params.radius, 1.0f);
+    const float tau = 16 / (lock_number * MAX(omega, 10.0f));
+    const float lambda = (inflow + v_climb) / tip_speed;
+    const float blowback = (8 * collective / 3 - 2 * lambda) / tip_speed;
+    const float lon_target = cyclic_lon - tau * gyro.y + blowback * velocity_air_bf.x;
+    const float lat_target = cyclic_lat - tau * gyro.x - blowback * velocity_air_bf.y;
+    const float k = MIN(dt / tau, 1.0f);
+    tpp_lon = constrain_float(tpp_lon + (lon_target - tpp_lon) * k, -tpp_limit, tpp_limit);
+    tpp_lat = constrain_float(tpp_lat + (lat_target - tpp_lat) * k, -tpp_limit, tpp_limit);
+
+    // thrust follows the disc, and the hub transmits a moment through
+    // its stiffness, which comes from the centrifugal load on the blades
+    force = Vector3f(-thrust * sinf(tpp_lon),
+                     thrust * sinf(tpp_lat),
+                     -thrust * cosf(tpp_lon) * cosf(tpp_lat));
+    const float stiffness = params.hub_stiffness * sq(omega / params.reference_speed);
+    const float moment_per_rad = thrust * params.hub_height + stiffness;
+    moment = Vector3f(moment_per_rad * tpp_lat,
+                      moment_per_rad * tpp_lon,
+                      0);
+}
+
+}  // namespace SITL
@@ -0,0 +1,107 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  blade element model of a helicopter main rotor
+*/
+
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+
+// radial stations along each blade, and azimuth positions the disc is
+// averaged over. A multiple of 4 stations keeps the element loop free
+// of a scalar tail when vectorised
+#define ROTOR_DISC_STATIONS 16
+#define ROTOR_DISC_AZIMUTHS 4
+
+namespace SITL {
+
+/*
+  a main rotor modelled as a disc. Thrust and torque come from blade
+  element theory integrated over radial stations and averaged over
+  azimuth, with uniform inflow from momentum theory. The tip path
+  plane follows cyclic with first order flapping dynamics, which gives
+  the rotor its rate damping, and speed stability from blowback
+ */
+class RotorDisc {
+public:
+    // rotor geometry and blade properties, defaults are for a 700 size heli
+    struct Params {
+        uint8_t blades = 2;
+        float radius = 0.69f;          // m
+        float root_cutout = 0.12f;     // m
+        float chord = 0.058f;          // m
+        float twist = 0.0f;            // tip minus root pitch, rad
+        float lift_slope = 5.7f;       // per rad
+        float cd0 = 0.011f;            // profile drag at zero lift
+        float cd2 = 0.4f;              // profile drag rise with aoa^2
+        float stall_aoa = radians(14); // rad
+        float blade_inertia = 0.024f;  // flapping inertia per blade, kg m^2
+        float hub_stiffness = 20.0f;   // hub moment per rad of disc tilt at reference speed, Nm/rad
+        float hub_height = 0.25f;      // rotor hub above cg, m
+        float reference_speed = 1500 * M_2PI / 60; // rad/s
+    };
+
+    RotorDisc();
+
+    // recompute station tables after changing params
+    void init(void);
+
+    /*
+      advance the rotor by dt. Blade pitch inputs are in radians, with
+      positive cyclic tilting the disc back and to the right. Velocity
+      is relative to the air and rates are the body rates
+     */
+    void update(float dt, float omega, float collective,
+                float cyclic_lon, float cyclic_lat,
+                const Vector3f &velocity_air_bf, const Vector3f &gyro);
+
+    // force and moment on the airframe from the last update, body frame
+    const Vector3f &get_force(void) const { return force; }
+    const Vector3f &get_moment(void) const { return moment; }
+
+    // aerodynamic torque resisting rotation, Nm
+    float get_torque(void) const { return torque; }
+
+    float get_thrust(void) const { return thrust; }
+
+    Params params;
+
+private:
+    void integrate_elements(float omega, float theta0, float v_inplane, float v_perp);
+
+    // per station radius, chord*dr, twist and their products
+    float station_r[ROTOR_DISC_STATIONS];
+    float station_cdr[ROTOR_DISC_STATIONS];
+    float station_crdr[ROTOR_DISC_STATIONS];
+    float station_twist[ROTOR_DISC_STATIONS];
+    float sin_azimuth[ROTOR_DISC_AZIMUTHS];
+
+    float disc_area;
+    float lock_number;
+
+    // state
+    float inflow;   // induced velocity through the disc, m/s
+    float tpp_lon;  // tip path plane tilt back, rad
+    float tpp_lat;  // tip path plane tilt right, rad
+
+    // outputs
+    float thrust;
+    float torque;
+    Vector3f force;
+    Vector3f moment;
+};
+
+}  // namespace SITL
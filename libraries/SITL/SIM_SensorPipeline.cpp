@@ -0,0 +1,61 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  noise generation and delay handling shared by the simulated sensors
+*/
+
+#include "SIM_SensorPipeline.h"
+
+namespace SITL {
+
+NoiseSource::NoiseSource()
+{
+    // give each instance a distinct, repeatable stream. The seeds are
+    // spread with a multiplicative hash as xorshift needs non-zero,
+    // well mixed state
+    static uint32_t instance_count;
+    const uint32_t base = ++instance_count * SITL_NOISE_LANES;
+    for (uint8_t i=0; i<SITL_NOISE_LANES; i++) {
+        uint32_t s = (base + i + 1) * 2654435761U;
+        state[i] = s != 0 ? s : 1;
+    }
+}
+
+/*
+  generate the next block of samples. The inner loop has no dependency
+  between lanes so it is vectorised at -O2 and above
+ */
+void NoiseSource::refill(void)
+{
+    uint32_t s[SITL_NOISE_LANES];
+    for (uint8_t i=0; i<SITL_NOISE_LANES; i++) {
+        s[i] = state[i];
+    }
+    for (uint8_t b=0; b<SITL_NOISE_BLOCK; b += SITL_NOISE_LANES) {
+        for (uint8_t i=0; i<SITL_NOISE_LANES; i++) {
+            s[i] ^= s[i] << 13;
+            s[i] ^= s[i] >> 17;
+            s[i] ^= s[i] << 5;
+            // reinterpret as signed to get a value in [-1, 1)
+            block[b+i] = (int32_t)s[i] * (1.0f / 2147483648.0f);
+        }
+    }
+    for (uint8_t i=0; i<SITL_NOISE_LANES; i++) {
+        state[i] = s[i];
+    }
+    index = 0;
+}
+
+}  // namespace SITL
@@ -0,0 +1,157 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  noise generation and delay handling shared by the simulated sensors
+*/
+
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+
+// number of independent generator lanes, chosen so the refill loop
+// maps onto 128 bit SIMD registers
+#define SITL_NOISE_LANES 4
+#define SITL_NOISE_BLOCK 64
+
+namespace SITL {
+
+/*
+  uniform noise in the range -1 to 1, produced by several xorshift32
+  generators stepped side by side so the compiler can vectorise the
+  refill. Samples are generated a block at a time, so the cost per
+  sample is a load and a compare. Each instance gets its own
+  deterministic stream
+ */
+class NoiseSource {
+public:
+    NoiseSource();
+
+    /* Do not allow copies */
+    NoiseSource(const NoiseSource &other) = delete;
+    NoiseSource &operator=(const NoiseSource&) = delete;
+
+    // return a random float between -1 and 1
+    float next(void) {
+        if (index >= SITL_NOISE_BLOCK) {
+            refill();
+        }
+        return block[index++];
+    }
+
+    // return a vector of three random floats between -1 and 1
+    Vector3f next_vec3f(void) {
+        if (index > SITL_NOISE_BLOCK-3) {
+            refill();
+        }
+        const Vector3f v(block[index], block[index+1], block[index+2]);
+        index += 3;
+        return v;
+    }
+
+private:
+    void refill(void);
+
+    uint32_t state[SITL_NOISE_LANES];
+    float block[SITL_NOISE_BLOCK];
+    uint8_t index = SITL_NOISE_BLOCK;
+};
+
+/*
+  a timestamped ring of sensor samples used to simulate sensor
+  delay. Samples are stored at most every period_ms, so the ring is
+  ordered by time and the sample nearest to the requested delay is
+  found with a binary search
+ */
+template <typename T, uint8_t N>
+class SensorDelay {
+public:
+    SensorDelay(uint32_t _period_ms) :
+        period_ms(_period_ms)
+    {}
+
+    // store a sample, if period_ms has passed since the last one
+    void push(uint32_t now_ms, const T &data) {
+        if (count != 0 && now_ms - ring[newest()].time < period_ms) {
+            return;
+        }
+        head = (head + 1) % N;
+        ring[head].time = now_ms;
+        ring[head].data = data;
+        if (count < N) {
+            count++;
+        }
+    }
+
+    /*
+      find the sample closest to delay_ms before now_ms. Returns false
+      if there is no sample within max_error_ms of that time, in which
+      case data is unchanged
+     */
+    bool get(uint32_t now_ms, uint32_t delay_ms, uint32_t max_error_ms, T &data) const {
+        if (count == 0) {
+            return false;
+        }
+        // work in age relative to the newest sample, which increases
+        // monotonically as we step back through the ring
+        const uint32_t newest_ms = ring[newest()].time;
+        const int32_t target_age = (int32_t)(newest_ms - (now_ms - delay_ms));
+        uint8_t best = 0;
+        if (target_age > 0) {
+            // first sample at least as old as the target
+            uint8_t lo = 0, hi = count - 1;
+            while (lo < hi) {
+                const uint8_t mid = (lo + hi) / 2;
+                if (age(newest_ms, mid) < (uint32_t)target_age) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            best = lo;
+            if (best > 0 &&
+                (uint32_t)target_age - age(newest_ms, best-1) < abs_delta(age(newest_ms, best), target_age)) {
+                best--;
+            }
+        }
+        if (abs_delta(age(newest_ms, best), target_age) >= max_error_ms) {
+            return false;
+        }
+        data = ring[slot(best)].data;
+        return true;
+    }
+
+private:
+    struct sample {
+        uint32_t time;
+        T data;
+    } ring[N];
+
+    const uint32_t period_ms;
+    uint8_t head = 0;
+    uint8_t count = 0;
+
+    uint8_t newest(void) const { return head; }
+
+    // slot holding the sample k steps older than the newest
+    uint8_t slot(uint8_t k) const { return (head + N - k) % N; }
+
+    uint32_t age(uint32_t newest_ms, uint8_t k) const { return newest_ms - ring[slot(k)].time; }
+
+    static uint32_t abs_delta(uint32_t age, int32_t target_age) {
+        return abs((int32_t)(age - target_age));
+    }
+};
+
+}  // namespace SITL
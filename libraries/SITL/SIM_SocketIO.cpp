@@ -0,0 +1,207 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  socket readiness handling shared by the external simulator backends
+*/
+
+#include "SIM_SocketIO.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#define SITL_SOCKETIO_EPOLL 1
+#else
+#define SITL_SOCKETIO_EPOLL 0
+#endif
+
+namespace SITL {
+
+SocketIO::SocketIO()
+{
+#if SITL_SOCKETIO_EPOLL
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd == -1) {
+        fprintf(stderr, "SITL: epoll_create1 failed: %s\n", strerror(errno));
+    }
+#endif
+}
+
+SocketIO::~SocketIO()
+{
+    if (epoll_fd != -1) {
+        close(epoll_fd);
+        epoll_fd = -1;
+    }
+}
+
+/*
+  return the slot holding sock, or -1
+ */
+int SocketIO::find(const SocketAPM &sock) const
+{
+    for (uint8_t i=0; i<SITL_SOCKETIO_MAX_SOCKETS; i++) {
+        if (sockets[i] == &sock) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+  add a socket to the wait set
+ */
+bool SocketIO::add(SocketAPM &sock)
+{
+    if (find(sock) != -1) {
+        return true;
+    }
+    for (uint8_t i=0; i<SITL_SOCKETIO_MAX_SOCKETS; i++) {
+        if (sockets[i] != nullptr) {
+            continue;
+        }
+#if SITL_SOCKETIO_EPOLL
+        if (epoll_fd != -1) {
+            struct epoll_event ev {};
+            ev.events = EPOLLIN;
+            ev.data.u32 = i;
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock.get_read_fd(), &ev) != 0) {
+                fprintf(stderr, "SITL: epoll_ctl failed: %s\n", strerror(errno));
+                return false;
+            }
+        }
+#endif
+        sockets[i] = &sock;
+        ready[i] = false;
+        return true;
+    }
+    return false;
+}
+
+/*
+  remove a socket from the wait set. This must be called before the
+  socket is closed
+ */
+void SocketIO::remove(SocketAPM &sock)
+{
+    const int i = find(sock);
+    if (i == -1) {
+        return;
+    }
+#if SITL_SOCKETIO_EPOLL
+    if (epoll_fd != -1) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, sock.get_read_fd(), nullptr);
+    }
+#endif
+    sockets[i] = nullptr;
+    ready[i] = false;
+}
+
+/*
+  wait for input on any socket in the set
+ */
+bool SocketIO::wait(uint32_t timeout_ms)
+{
+    memset(ready, 0, sizeof(ready));
+
+#if SITL_SOCKETIO_EPOLL
+    if (epoll_fd != -1) {
+        struct epoll_event events[SITL_SOCKETIO_MAX_SOCKETS];
+        const int n = epoll_wait(epoll_fd, events, SITL_SOCKETIO_MAX_SOCKETS, timeout_ms);
+        for (int i=0; i<n; i++) {
+            ready[events[i].data.u32] = true;
+        }
+        return n > 0;
+    }
+#endif
+
+    // fall back to poll() when epoll is not available
+    struct pollfd fds[SITL_SOCKETIO_MAX_SOCKETS];
+    uint8_t slot[SITL_SOCKETIO_MAX_SOCKETS];
+    uint8_t nfds = 0;
+    for (uint8_t i=0; i<SITL_SOCKETIO_MAX_SOCKETS; i++) {
+        if (sockets[i] != nullptr) {
+            fds[nfds].fd = sockets[i]->get_read_fd();
+            fds[nfds].events = POLLIN;
+            fds[nfds].revents = 0;
+            slot[nfds++] = i;
+        }
+    }
+    if (poll(fds, nfds, timeout_ms) <= 0) {
+        return false;
+    }
+    bool ret = false;
+    for (uint8_t i=0; i<nfds; i++) {
+        if (fds[i].revents & POLLIN) {
+            ready[slot[i]] = true;
+            ret = true;
+        }
+    }
+    return ret;
+}
+
+/*
+  return true if sock had input pending at the last wait()
+ */
+bool SocketIO::readable(const SocketAPM &sock) const
+{
+    const int i = find(sock);
+    return i != -1 && ready[i];
+}
+
+/*
+  read all queued datagrams, keeping the newest one of the right size
+ */
+bool SocketIO::recv_latest(SocketAPM &sock, void *pkt, size_t size)
+{
+    uint8_t buf[2048];
+    if (size >= sizeof(buf)) {
+        return false;
+    }
+    bool got_packet = false;
+    ssize_t ret;
+    // the socket is known to be readable, so skip the select() in
+    // SocketAPM::recv and read until it would block. Read into a
+    // larger buffer so oversized datagrams are not truncated to size
+    while ((ret = ::recv(sock.get_read_fd(), buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        if ((size_t)ret == size) {
+            memcpy(pkt, buf, size);
+            got_packet = true;
+        }
+    }
+    return got_packet;
+}
+
+/*
+  discard all pending input
+ */
+bool SocketIO::drain(SocketAPM &sock)
+{
+    uint8_t buf[1024];
+    ssize_t received;
+    errno = 0;
+    do {
+        received = ::recv(sock.get_read_fd(), buf, sizeof(buf), MSG_DONTWAIT);
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != 0) {
+            fprintf(stderr, "SITL: error recv on socket: %s\n", strerror(errno));
+        }
+    } while (received > 0);
+    return received != 0;
+}
+
+}  // namespace SITL
@@ -0,0 +1,78 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  socket readiness handling shared by the external simulator backends
+*/
+
+#pragma once
+
+#include <AP_HAL/utility/Socket.h>
+
+#define SITL_SOCKETIO_MAX_SOCKETS 4
+
+namespace SITL {
+
+/*
+  wait for input on the sockets connecting us to an external physics
+  engine. On Linux the sockets are registered once with epoll so each
+  wait is a single syscall with no fd_set setup, other systems fall
+  back to poll(). All sockets should be non-blocking
+ */
+class SocketIO {
+public:
+    SocketIO();
+    ~SocketIO();
+
+    /* Do not allow copies */
+    SocketIO(const SocketIO &other) = delete;
+    SocketIO &operator=(const SocketIO&) = delete;
+
+    // add a socket to the wait set, returns false if the set is full
+    bool add(SocketAPM &sock);
+
+    // remove a socket from the wait set
+    void remove(SocketAPM &sock);
+
+    // wait up to timeout_ms for input on any socket in the set,
+    // returns true if at least one socket is readable
+    bool wait(uint32_t timeout_ms);
+
+    // return true if sock had input pending at the last wait()
+    bool readable(const SocketAPM &sock) const;
+
+    /*
+      read every queued datagram from sock, keeping the newest one of
+      exactly size bytes in pkt. Returns false if there was none. This
+      drains any backlog in the same pass so we never run behind the
+      physics engine
+     */
+    static bool recv_latest(SocketAPM &sock, void *pkt, size_t size);
+
+    // discard all pending input on sock, returns false if a stream
+    // socket has been closed by the other end
+    static bool drain(SocketAPM &sock);
+
+private:
+    int find(const SocketAPM &sock) const;
+
+    // registered sockets, nullptr marks a free slot
+    SocketAPM *sockets[SITL_SOCKETIO_MAX_SOCKETS] {};
+    bool ready[SITL_SOCKETIO_MAX_SOCKETS] {};
+
+    // epoll instance, -1 when using poll()
+    int epoll_fd = -1;
+};
+
+}  // namespace SITL
@@ -44,6 +44,8 @@ XPlane::XPlane(const char *home_str, const char *frame_str) :
     heli_frame = (strstr(frame_str, "-heli") != nullptr);
 
     socket_in.bind("0.0.0.0", bind_port);
+    socket_in.set_blocking(false);
+    socket_io.add(socket_in);
     printf("Waiting for XPlane data on UDP port %u and sending to port %u\n",
            (unsigned)bind_port, (unsigned)xplane_port);
 
@@ -120,7 +122,10 @@ bool XPlane::receive_data(void)
         now+1 >= last_data_time_ms + xplane_frame_time) {
         wait_time_ms = 10;
     }
-    ssize_t len = socket_in.recv(pkt, sizeof(pkt), wait_time_ms);
+    ssize_t len = -1;
+    if (socket_io.wait(wait_time_ms)) {
+        len = socket_in.recv(pkt, sizeof(pkt), 0);
+    }
     
     if (len < pkt_len+5 || memcmp(pkt, "DATA", 4) != 0) {
         // not a data packet we understand
@@ -21,6 +21,7 @@
 #include <AP_HAL/utility/Socket.h>
 
 #include "SIM_Aircraft.h"
+#include "SIM_SocketIO.h"
 
 namespace SITL {
 
@@ -51,6 +52,7 @@ private:
     // udp socket, input and output
     SocketAPM socket_in{true};
     SocketAPM socket_out{true};
+    SocketIO socket_io;
 
     uint64_t time_base_us;
     uint32_t last_data_time_ms;
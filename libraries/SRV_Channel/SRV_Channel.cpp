@@ -123,8 +123,11 @@ void SRV_Channel::calc_pwm(int16_t output_scaled)
 
 void SRV_Channel::set_output_pwm(uint16_t pwm)
 {
+    // the mask is shared by all channels, which may be set from more than one thread
+    SRV_Channels::output_lock();
     output_pwm = pwm;
     have_pwm_mask |= (1U<<ch_num);
+    SRV_Channels::output_unlock();
 }
 
 // set angular range of scaled output
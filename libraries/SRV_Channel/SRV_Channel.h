@@ -421,6 +421,11 @@ public:
         return SRV_Channel::Aux_servo_function_t((SRV_Channel::k_motor9+(channel-8)));
     }
     
+    /*
+      start grouping channel outputs. Calls may be nested. The main loop
+      and other threads cork separately, so the outputs of each are held
+      until its own outermost push()
+     */
     static void cork();
 
     static void push();
@@ -458,6 +463,52 @@ private:
     static AP_BLHeli *blheli_ptr;
 #endif
     static uint16_t disabled_mask;
+
+    // outputs held while corked. cork() and push() may be called from
+    // the main loop and from other threads, such as a rate loop thread
+    // or the failsafe timer, so the main loop and the other threads each
+    // have their own cork. Threads other than the main loop must not
+    // cork at the same time as each other. This state is only changed
+    // while holding output_sem, which is never held across I/O
+    struct cork_state {
+        uint8_t depth;
+        uint32_t mask;
+        uint16_t pwm[NUM_SERVO_CHANNELS];
+    };
+    static AP_HAL::Semaphore *output_sem;
+    static cork_state corks[2];
+
+    // outputs waiting to be sent to the HAL, and whether the HAL and the
+    // output backends are to be pushed
+    static uint32_t flush_mask;
+    static uint16_t flush_pwm[NUM_SERVO_CHANNELS];
+    static bool flush_push;
+
+    // held by the one thread sending outputs to the HAL and the output
+    // backends. It is only taken without waiting, so a thread such as the
+    // failsafe timer never blocks behind bus I/O
+    static AP_HAL::Semaphore *flush_sem;
+
+    static void output_lock(void) {
+        if (output_sem != nullptr) {
+            output_sem->take_blocking();
+        }
+    }
+    static void output_unlock(void) {
+        if (output_sem != nullptr) {
+            output_sem->give();
+        }
+    }
+
+    // send a channel output to the HAL, or hold it while corked
+    static void write_output(uint8_t chan, uint16_t pwm);
+
+    // the cork of the calling thread
+    static cork_state &thread_cork(void);
+
+    // send the outputs waiting to be flushed unless another thread is
+    // already sending, in which case it sends them before it finishes
+    static void flush(void);
     
     SRV_Channel obj_channels[NUM_SERVO_CHANNELS];
 
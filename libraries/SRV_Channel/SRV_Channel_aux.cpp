@@ -51,7 +51,7 @@ void SRV_Channel::output_ch(void)
         }
     }
     if (!(SRV_Channels::disabled_mask & (1U<<ch_num))) {
-        hal.rcout->write(ch_num, output_pwm);
+        SRV_Channels::write_output(ch_num, output_pwm);
     }
 }
 
@@ -133,6 +133,15 @@ void SRV_Channels::update_aux_servo_function(void)
     if (!channels) {
         return;
     }
+    // created here rather than in the constructor as the HAL may not
+    // be constructed yet. This runs during vehicle setup, before any
+    // thread other than the main loop outputs to the servos
+    if (output_sem == nullptr) {
+        output_sem = hal.util->new_semaphore();
+    }
+    if (flush_sem == nullptr) {
+        flush_sem = hal.util->new_semaphore();
+    }
     function_mask.clearall();
 
     for (uint8_t i = 0; i < SRV_Channel::k_nr_aux_servo_functions; i++) {
@@ -464,7 +473,9 @@ void SRV_Channels::set_output_scaled(SRV_Channel::Aux_servo_function_t function,
 {
     if (function < SRV_Channel::k_nr_aux_servo_functions) {
         functions[function].output_scaled = value;
+        output_lock();
         SRV_Channel::have_pwm_mask &= ~functions[function].channel_mask;
+        output_unlock();
     }
 }
 
@@ -39,6 +39,12 @@ AP_BLHeli *SRV_Channels::blheli_ptr;
 #endif
 
 uint16_t SRV_Channels::disabled_mask;
+AP_HAL::Semaphore *SRV_Channels::output_sem;
+SRV_Channels::cork_state SRV_Channels::corks[2];
+uint32_t SRV_Channels::flush_mask;
+uint16_t SRV_Channels::flush_pwm[NUM_SERVO_CHANNELS];
+bool SRV_Channels::flush_push;
+AP_HAL::Semaphore *SRV_Channels::flush_sem;
 
 bool SRV_Channels::disabled_passthrough;
 bool SRV_Channels::initialised;
@@ -211,11 +217,43 @@ void SRV_Channels::set_output_pwm_chan(uint8_t chan, uint16_t value)
 }
 
 /*
-  wrapper around hal.rcout->cork()
+  the cork of the calling thread. The main loop has its own, so it is
+  never held up by a cork of the rate loop thread or the failsafe timer
+ */
+SRV_Channels::cork_state &SRV_Channels::thread_cork(void)
+{
+    return corks[hal.scheduler->in_main_thread() ? 0 : 1];
+}
+
+/*
+  start holding the channel outputs of the calling thread
  */
 void SRV_Channels::cork()
 {
-    hal.rcout->cork();
+    output_lock();
+    thread_cork().depth++;
+    output_unlock();
+}
+
+/*
+  send a channel output to the HAL. While corked the output is held so
+  that all channels changed in a loop reach the HAL in a single
+  write_mask() call
+ */
+void SRV_Channels::write_output(uint8_t chan, uint16_t pwm)
+{
+    output_lock();
+    cork_state &c = thread_cork();
+    if (c.depth != 0) {
+        c.pwm[chan] = pwm;
+        c.mask |= 1U<<chan;
+        output_unlock();
+        return;
+    }
+    flush_pwm[chan] = pwm;
+    flush_mask |= 1U<<chan;
+    output_unlock();
+    flush();
 }
 
 /*
@@ -223,28 +261,94 @@ void SRV_Channels::cork()
  */
 void SRV_Channels::push()
 {
-    hal.rcout->push();
-    
-    // give volz library a chance to update
-    volz_ptr->update();
+    output_lock();
+    cork_state &c = thread_cork();
+    if (c.depth > 1) {
+        // an outer cork() of this thread is still active
+        c.depth--;
+        output_unlock();
+        return;
+    }
+    c.depth = 0;
+    for (uint8_t i = 0; i < NUM_SERVO_CHANNELS; i++) {
+        if (c.mask & (1U<<i)) {
+            flush_pwm[i] = c.pwm[i];
+        }
+    }
+    flush_mask |= c.mask;
+    c.mask = 0;
+    flush_push = true;
+    output_unlock();
+    flush();
+}
+
+/*
+  send the waiting outputs to the HAL, and push the HAL and the output
+  backends if requested. The outputs are copied under output_sem and
+  sent without it, so only the thread sending can be held up by the I/O
+ */
+void SRV_Channels::flush(void)
+{
+    while (true) {
+        if (flush_sem != nullptr && !flush_sem->take_nonblocking()) {
+            // the thread holding it checks for waiting outputs before it returns
+            return;
+        }
 
-    // give sbus library a chance to update
-    sbus_ptr->update();
+        uint16_t pwm[NUM_SERVO_CHANNELS];
+        output_lock();
+        // channels may have been disabled since their output was held
+        const uint32_t mask = flush_mask & ~uint32_t(disabled_mask);
+        const bool do_push = flush_push;
+        memcpy(pwm, flush_pwm, sizeof(pwm));
+        flush_mask = 0;
+        flush_push = false;
+        output_unlock();
+
+        if (do_push) {
+            hal.rcout->cork();
+        }
+        if (mask != 0) {
+            hal.rcout->write_mask(mask, pwm);
+        }
+        if (do_push) {
+            hal.rcout->push();
+
+            // give volz library a chance to update
+            volz_ptr->update();
+
+            // give sbus library a chance to update
+            sbus_ptr->update();
 
 #if HAL_SUPPORT_RCOUT_SERIAL
-    // give blheli telemetry a chance to update
-    blheli_ptr->update_telemetry();
+            // give blheli telemetry a chance to update
+            blheli_ptr->update_telemetry();
 #endif
 
 #if HAL_WITH_UAVCAN
-    // push outputs to UAVCAN
-    uint8_t can_num_ifaces = AP_BoardConfig_CAN::get_can_num_ifaces();
-    for (uint8_t i = 0; i < MAX_NUMBER_OF_CAN_DRIVERS && i < can_num_ifaces; i++) {
-        AP_UAVCAN *ap_uavcan = AP_UAVCAN::get_uavcan(i);
-        if (ap_uavcan == nullptr) {
-            continue;
+            // push outputs to UAVCAN
+            uint8_t can_num_ifaces = AP_BoardConfig_CAN::get_can_num_ifaces();
+            for (uint8_t i = 0; i < MAX_NUMBER_OF_CAN_DRIVERS && i < can_num_ifaces; i++) {
+                AP_UAVCAN *ap_uavcan = AP_UAVCAN::get_uavcan(i);
+                if (ap_uavcan == nullptr) {
+                    continue;
+                }
+                ap_uavcan->SRV_push_servos();
+            }
+#endif // HAL_WITH_UAVCAN
+        }
+
+        if (flush_sem == nullptr) {
+            return;
+        }
+        flush_sem->give();
+
+        // another thread may have left outputs for us while we were sending
+        output_lock();
+        const bool more = flush_mask != 0 || flush_push;
+        output_unlock();
+        if (!more) {
+            return;
         }
-        ap_uavcan->SRV_push_servos();
     }
-#endif // HAL_WITH_UAVCAN
 }